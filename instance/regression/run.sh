@@ -0,0 +1,15 @@
+#!/bin/bash
+# run the solver on every regression instance and check its output.
+# usage: instance/regression/run.sh [solver] (default ./solver)
+solver=${1:-./solver}
+dir=$(dirname "$0")
+failed=0
+for inst in "$dir"/*.hgr "$dir"/*.gr "$dir"/*.txt; do
+    [ -f "$inst" ] || continue
+    out=$(mktemp)
+    timeout -s TERM 10 "$solver" < "$inst" > "$out"
+    if result=$(python3 "$dir/verify.py" "$inst" "$out"); then echo "$(basename "$inst"): $result"
+    else echo "$(basename "$inst"): FAILED"; failed=1; fi
+    rm -f "$out"
+done
+exit $failed
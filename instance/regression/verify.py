@@ -0,0 +1,49 @@
+# check that a solver output (size line followed by 1-based set ids) is a valid cover of the input.
+# usage: python3 verify.py input_file output_file
+import sys
+
+
+def read_instance(path):
+    """return (set number, elements as lists of covering sets) for the pace hs/ds, dimacs and or-library formats."""
+    tokens_by_line = [line.split() for line in open(path)]
+    tokens_by_line = [t for t in tokens_by_line if t and t[0] != 'c']
+    head = tokens_by_line[0]
+    if head[0] == 'p' and head[1] == 'hs':
+        return int(head[2]), [list(map(int, t)) for t in tokens_by_line[1:]]
+    if head[0] == 'p':
+        n = int(head[2])
+        adj = [[v] for v in range(n + 1)]
+        for t in tokens_by_line[1:]:
+            u, v = (int(t[1]), int(t[2])) if t[0] == 'e' else (int(t[0]), int(t[1]))
+            adj[u].append(v); adj[v].append(u)
+        return n, adj[1:]
+    # or-library: rows (elements) and columns (sets), the column costs, then every row as its size and columns
+    nums = [int(x) for t in tokens_by_line for x in t]
+    row_num, col_num = nums[0], nums[1]
+    pos = 2 + col_num
+    rows = []
+    for _ in range(row_num):
+        k = nums[pos]
+        rows.append(nums[pos + 1:pos + 1 + k])
+        pos += 1 + k
+    return col_num, rows
+
+
+def main():
+    set_num, elements = read_instance(sys.argv[1])
+    out = open(sys.argv[2]).read().split()
+    if not out:
+        sys.exit('empty output')
+    size, picked = int(out[0]), [int(x) for x in out[1:]]
+    if size != len(picked) or len(set(picked)) != size:
+        sys.exit('broken solution size')
+    if any(s < 1 or s > set_num for s in picked):
+        sys.exit('set id out of range')
+    picked = set(picked)
+    for e, sets in enumerate(elements):
+        if not picked.intersection(sets):
+            sys.exit('element %d is not covered' % (e + 1))
+    print('OK', size)
+
+
+main()
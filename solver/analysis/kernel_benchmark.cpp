@@ -0,0 +1,84 @@
+//micro-benchmark of the sorted-subset kernels, built apart from the solver:
+//g++ -o kernel_benchmark -O2 -I . solver/analysis/kernel_benchmark.cpp solver/tools/*.cpp -std=c++2a -pthread
+
+#include "solver/lib/instance.h"
+#include "solver/tools/SortedIds.h"
+#include "solver/tools/Random.h"
+
+namespace PACE2025_HS {
+    //the subset test used by the reductions before goal::isSortedSubset
+    static bool lower_bound_subset(Span<const int> S1, Span<const int> S2) {
+        if (S1.size() > S2.size()) return false;
+        if (S1.back() > S2.back()) { return false; }
+        if (S1.front() < S2.front()) { return false; }
+        bool dominated = false;
+        auto iter_1 = S1.begin();
+        auto iter_2 = S2.begin();
+        while (iter_1 != S1.end() && iter_2 != S2.end()) {
+            int val1 = *iter_1;
+            iter_2 = std::lower_bound(iter_2, S2.end(), val1);
+            if (iter_2 == S2.end() || *iter_2 != val1) {
+                dominated = false; break;
+            }
+            else {
+                ++iter_1; ++iter_2;
+                if (iter_1 == S1.end()) {
+                    dominated = true; break;
+                }
+                if (S2.end() - iter_2 < S1.end() - iter_1) {
+                    dominated = false; break;
+                }
+            }
+        }
+        return dominated;
+    }
+
+    //compare the subset kernels on random sorted lists of the given sizes.
+    //half of the first lists are real subsets, the other half contain one id which is not in the second list.
+    static void benchmark_subset_kernels(int size1, int size2, int pair_num = 100000, int repeat = 10) {
+        goal::Random rand(20250601);
+        int universe = size2 * 4;
+        Vec<Vec<int>> lists1(pair_num), lists2(pair_num);
+        for (int p = 0; p < pair_num; ++p) {
+            Vec<int>& l2 = lists2[p];
+            while (int(l2.size()) < size2) { l2.push_back(rand.pick(universe)); }
+            std::sort(l2.begin(), l2.end());
+            l2.erase(std::unique(l2.begin(), l2.end()), l2.end());
+            Vec<int>& l1 = lists1[p];
+            for (int i = 0; i < size1 && i < int(l2.size()); ++i) { l1.push_back(l2[rand.pick(int(l2.size()))]); }
+            if (p % 2) {
+                int missing = rand.pick(universe);
+                while (std::binary_search(l2.begin(), l2.end(), missing)) { missing = rand.pick(universe); }
+                l1.push_back(missing);
+            }
+            std::sort(l1.begin(), l1.end());
+            l1.erase(std::unique(l1.begin(), l1.end()), l1.end());
+        }
+
+        auto run = [&](const char* name, auto&& subset) {
+            goal::Timer timer;
+            long long hits = 0;
+            for (int r = 0; r < repeat; ++r) {
+                for (int p = 0; p < pair_num; ++p) { hits += subset(Span<const int>(lists1[p]), Span<const int>(lists2[p])); }
+            }
+            printf("\t%-12s %8.3f s (%lld subsets)\n", name, timer.elapsedSeconds(), hits);
+        };
+
+        printf("Subset kernels |S1| = %d, |S2| = %d:\n", size1, size2);
+        run("lower_bound", lower_bound_subset);
+        run("kernel", [](Span<const int> l, Span<const int> r) { return goal::isSortedSubset(l, r); });
+        run("scalar", [](Span<const int> l, Span<const int> r) {
+            return l.size() <= r.size() && l.front() >= r.front() && l.back() <= r.back() && goal::sorted_ids_impl::isSubsetScalar(l, r);
+        });
+    }
+}
+
+int main() {
+    //the row lengths seen by the dominance tests: short rows, similar lengths and skewed (galloping) lengths
+    PACE2025_HS::benchmark_subset_kernels(4, 8);
+    PACE2025_HS::benchmark_subset_kernels(8, 16);
+    PACE2025_HS::benchmark_subset_kernels(16, 24);
+    PACE2025_HS::benchmark_subset_kernels(32, 60);
+    PACE2025_HS::benchmark_subset_kernels(4, 256);
+    PACE2025_HS::benchmark_subset_kernels(8, 1024, 20000);
+}
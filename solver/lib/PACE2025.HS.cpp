@@ -13,6 +13,8 @@
 #include "solver/analysis/analyzer.h"
 #include "solver/lib/ls_solver.h"
 #include "solver/tools/NaiveThreadPool.h"
+#include "solver/tools/MappedFile.h"
+
 
 
 // 捕获全局终止信号
@@ -80,7 +82,7 @@ namespace PACE2025_HS {
 
 			logger << "Instance Name: " << inst_name << std::endl;
 
-			SimplifiedSCInstance sins(oins, logger);
+			SimplifiedSCInstance sins(std::move(oins), logger);
 			stpw.printTime("Instance Reading Completed", logger);
 			sins.reduction(60);
 			//sins.print_statistics();
@@ -97,13 +99,13 @@ namespace PACE2025_HS {
 			stpw.printTime("Greedy by Iterated Pagerank Completed", logger);
 
 			Vec<SetId> completed_greedy_res = sins.generate_complete_sol(greedy_res);
-			logger << "Validity: " << oins.is_valid_solution(completed_greedy_res) << ", Set Size: " << completed_greedy_res.size() << std::endl;
+			logger << "Validity: " << sins.is_valid_complete_solution(completed_greedy_res) << ", Set Size: " << completed_greedy_res.size() << std::endl;
 
 			WVNS4SCP ls_solver(sins, greedy_res, /*113*//*998244353*/int(time(0)));
-			Vec<SetId> ls_res = ls_solver.solve(1000000000, 180);
+			Vec<SetId> ls_res = ls_solver.solve(1000000000, 180 + (long long)sins.reduction_time_left_);
 
 			Vec<SetId> completed_ls_res = sins.generate_complete_sol(ls_res);
-			logger << "Validity: " << oins.is_valid_solution(completed_ls_res) << ", Set Size: " << completed_ls_res.size() << std::endl;
+			logger << "Validity: " << sins.is_valid_complete_solution(completed_ls_res) << ", Set Size: " << completed_ls_res.size() << std::endl;
 		
 			instance_log_file.close();
 
@@ -137,7 +139,7 @@ namespace PACE2025_HS {
 
 			logger << "Instance Name: " << inst_name << std::endl;
 
-			SimplifiedSCInstance sins(oins, logger);
+			SimplifiedSCInstance sins(std::move(oins), logger);
 			stpw.printTime("Instance Reading Completed", logger);
 			sins.reduction(60);
 			//sins.print_statistics();
@@ -155,13 +157,13 @@ namespace PACE2025_HS {
 			stpw.printTime("Greedy by Iterated Pagerank Completed", logger);
 
 			Vec<SetId> completed_greedy_res = sins.generate_complete_sol(greedy_res);
-			logger << "Validity: " << oins.is_valid_solution(completed_greedy_res) << ", Set Size: " << completed_greedy_res.size() << std::endl;
+			logger << "Validity: " << sins.is_valid_complete_solution(completed_greedy_res) << ", Set Size: " << completed_greedy_res.size() << std::endl;
 
 			WVNS4SCP ls_solver(sins, greedy_res, /*113*//*998244353*/int(time(0)));
-			Vec<SetId> ls_res = ls_solver.solve(1000000000, 180);
+			Vec<SetId> ls_res = ls_solver.solve(1000000000, 180 + (long long)sins.reduction_time_left_);
 
 			Vec<SetId> completed_ls_res = sins.generate_complete_sol(ls_res);
-			logger << "Validity: " << oins.is_valid_solution(completed_ls_res) << ", Set Size: " << completed_ls_res.size() << std::endl;
+			logger << "Validity: " << sins.is_valid_complete_solution(completed_ls_res) << ", Set Size: " << completed_ls_res.size() << std::endl;
 
 			return (int)completed_ls_res.size();
 		};
@@ -173,24 +175,94 @@ namespace PACE2025_HS {
 		}
 	}
 
+	//write "id\n" for the size and every (1-based) id of the solution with a single write,
+	//so that the output finishes quickly even when it starts right at the deadline
+	static void write_solution(const Vec<SetId>& sol) {
+		static constexpr char digit_pairs[] =
+			"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+			"4041424344454647484950515253545556575859606162636465666768697071727374757677787980"
+			"81828384858687888990919293949596979899";
+
+		Vec<char> buffer((sol.size() + 1) * 11);
+		char* ptr = buffer.data();
+		auto append_line = [&](unsigned int val) {
+			char digits[10];
+			char* d = digits + 10;
+			while (val >= 100) {
+				unsigned int r = val % 100; val /= 100;
+				d -= 2; memcpy(d, digit_pairs + 2 * r, 2);
+			}
+			if (val >= 10) { d -= 2; memcpy(d, digit_pairs + 2 * val, 2); }
+			else { *--d = char('0' + val); }
+			size_t len = size_t(digits + 10 - d);
+			memcpy(ptr, d, len); ptr += len;
+			*ptr++ = '\n';
+		};
+		append_line(unsigned(sol.size()));
+		for (SetId s : sol) { append_line(unsigned(s + 1)); }
+
+		size_t len = size_t(ptr - buffer.data());
+		fflush(stdout);
+		#ifdef _WIN32
+		fwrite(buffer.data(), 1, len, stdout);
+		fflush(stdout);
+		#else
+		const char* cur = buffer.data();
+		while (len > 0) {
+			ssize_t n = write(STDOUT_FILENO, cur, len);
+			if (n < 0) {
+				if (errno == EINTR) { continue; }
+				fatalif(true, "Write solution failed:");
+			}
+			cur += n; len -= size_t(n);
+		}
+		#endif // _WIN32
+	}
+
 	static void submit_run() {
 		goal::Log logger(Log::Off, std::cout);
 		OriginalSCInstance oins;
-		oins.read_hs_instance(stdin);
-		SimplifiedSCInstance sins(oins, logger);
-
-		sins.reduction(60);
+		Str cache_path;
+		bool warm_start = false;
+		//warm runs (same input) skip parsing and reduction, the whole input is needed to find the cache
+		goal::MappedFile input_file;
+		if (reduction_cache_enabled()) {
+			if (!input_file.open(stdin)) { fatalif(true, "Read input failed!"); }
+			cache_path = reduction_cache_path(input_file.data(), input_file.size());
+			warm_start = oins.read_reduced_cache_header(cache_path);
+			if (!warm_start) { oins.read_hs_instance(input_file.data(), input_file.size()); }
+		}
+		else {
+			oins.read_hs_instance(stdin);
+		}
+		SimplifiedSCInstance sins(std::move(oins), logger);
+
+		if (warm_start && !sins.load_reduced_instance(cache_path)) {
+			//a broken cache file is rebuilt from the input, which is still mapped
+			warm_start = false;
+			OriginalSCInstance cold_oins;
+			cold_oins.read_hs_instance(input_file.data(), input_file.size());
+			sins = SimplifiedSCInstance(std::move(cold_oins), logger);
+		}
+		input_file.close();
+		if (!warm_start) {
+			sins.reduction(60);
+			if (!cache_path.empty() && !global_exit_signal_reached) {
+				sins.save_reduced_instance(cache_path);
+			}
+		}
 		//sins.try_to_initialize_hop2_neighbor(30);
 
+
 		GreedyGenerator greedy_solver(sins);
 		//Vec<SetId> greedy_res = greedy_solver.greedy_by_cover_count(60.0);
-		Vec<SetId> greedy_res = greedy_solver.greedy_by_iterated_pagerank(16, 60.0);
+		//the time the reduction left over extends the only limited stage, the local search runs until the signal anyway
+		Vec<SetId> greedy_res = greedy_solver.greedy_by_iterated_pagerank(16, 60 + (long long)sins.reduction_time_left_);
 		WVNS4SCP local_search_solver(sins, greedy_res, /*113*//*998244353*/int(time(0)));
 		Vec<SetId> ls_res = local_search_solver.solve(1000000000, 1000000);
 
 		Vec<SetId> completed_res = sins.generate_complete_sol(ls_res);
-		printf("%d\n", (int)completed_res.size());
-		for (SetId s : completed_res) { printf("%d\n", s + 1); }
+		write_solution(completed_res);
 	}
 }
 
@@ -0,0 +1,204 @@
+#include "instance.h"
+#include "solver/tools/DenseBitset.h"
+#include "solver/tools/RadixSort.h"
+
+namespace PACE2025_HS {
+    //dominating set rules on the single closed-neighborhood adjacency (row v is N[v], sorted),
+    //applied before the set and element views are split so that they run on half the memory.
+    //the state is the usual one of annotated dominating set:
+    //  fixed        the vertex is in the solution
+    //  dominated    the vertex needs no (further) dominator, i.e. its element is removed
+    //  excluded     the vertex is never picked, i.e. its set is removed
+    //every removed set, element and set incidence is credited to the rule that removed it (see the end).
+    void SimplifiedSCInstance::reduce_dominating_set_graph(const goal::Timer& timer,
+        ReductionRuleStats& twin_stats, ReductionRuleStats& leaf_stats, ReductionRuleStats& alber_stats) {
+        const Csr<SetId>& adj = sets_;
+        const SetId vertex_num = set_num_;
+
+        enum Rule { Twin, Leaf, Alber, RuleNumber };
+        ReductionRuleStats* rule_stats[RuleNumber] = { &twin_stats, &leaf_stats, &alber_stats };
+        //the rule which fixed or excluded the vertex, and the one which dominated it
+        Vec<signed char> set_rules(vertex_num, -1), element_rules(vertex_num, -1);
+        Rule rule = Twin;
+
+        goal::DenseBitset fixed(vertex_num), dominated(vertex_num), excluded(vertex_num);
+        auto dominate = [&](SetId v) {
+            if (dominated.insert(v)) { element_rules[v] = rule; }
+        };
+        auto fix = [&](SetId v) {
+            if (!fixed.insert(v)) { return; }
+            set_rules[v] = rule;
+            for (SetId u : adj[v]) { dominate(u); }
+        };
+
+        //true twins (N[u] = N[v]): every dominator of one dominates the other and the two sets are equal,
+        //so only the smallest vertex of a group keeps its set and its element.
+        goal::Timer rule_timer;
+        struct HashedRow { unsigned long long hash; SetId id; };
+        Vec<HashedRow> hashed_rows(vertex_num);
+        run_in_parallel_blocks(global_thread_number, vertex_num, 4096, [&](int, Count begin, Count end) {
+            for (SetId v = SetId(begin); v < SetId(end); ++v) {
+                Span<const SetId> row = adj[v];
+                hashed_rows[v] = { hash_input_bytes(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(SetId)), v };
+            }
+        });
+        goal::radixSort(hashed_rows, [](const HashedRow& hr) { return hr.hash; });
+        SetId twin_num = 0;
+        for (size_t begin = 0, end = 0; begin < hashed_rows.size(); begin = end) {
+            for (end = begin + 1; end < hashed_rows.size() && hashed_rows[end].hash == hashed_rows[begin].hash; ++end) {}
+            for (size_t i = begin + 1; i < end; ++i) {
+                Span<const SetId> row = adj[hashed_rows[i].id];
+                for (size_t j = begin; j < i; ++j) {
+                    SetId t = hashed_rows[j].id;
+                    if (excluded.contains(t)) { continue; }
+                    ++twin_stats.subset_tests;
+                    if (std::equal(row.begin(), row.end(), adj[t].begin(), adj[t].end())) {
+                        SetId v = hashed_rows[i].id;
+                        excluded.insert(v); set_rules[v] = rule; dominate(v); ++twin_num;
+                        break;
+                    }
+                }
+            }
+        }
+        Vec<HashedRow>().swap(hashed_rows);
+        twin_stats.calls = 1;
+        twin_stats.candidates = vertex_num;
+        twin_stats.seconds = rule_timer.elapsedSeconds();
+
+        //leaves: the only neighbor of an isolated or degree-1 vertex dominates everything the vertex does.
+        //the neighbor is only excluded if it is a twin of the leaf, which then has the same set.
+        rule = Leaf;
+        rule_timer = goal::Timer();
+        for (SetId v = 0; v < vertex_num; ++v) {
+            if (dominated.contains(v)) { continue; }
+            ++leaf_stats.candidates;
+            Span<const SetId> row = adj[v];
+            if (row.size() == 1) { fix(v); }
+            else if (row.size() == 2) {
+                SetId u = (row[0] == v) ? row[1] : row[0];
+                fix(excluded.contains(u) ? v : u);
+            }
+        }
+        SetId leaf_fixed_num = SetId(fixed.size());
+        leaf_stats.calls = 1;
+        leaf_stats.seconds = rule_timer.elapsedSeconds();
+
+        //Alber's rule for a single vertex: v is picked if an undominated vertex w in N[v] can only be
+        //dominated by vertices x whose undominated neighbors are all in N[v], since v can replace any such x.
+        //x "exits" N[v] if it has an undominated neighbor outside of N[v].
+        Vec<SetId> mark(vertex_num, -1);
+        //exit_state[x] is 2 * v + 1 if x exits N[v], 2 * v if it does not.
+        //a state kept from an earlier pass is still safe: vertices only get dominated, so x only stops exiting.
+        Vec<Count> exit_state(vertex_num, -1);
+        auto exits = [&](SetId x, SetId v) {
+            if (exit_state[x] >> 1 != v) {
+                bool exit = false;
+                for (SetId y : adj[x]) {
+                    if (mark[y] != v && !dominated.contains(y)) { exit = true; break; }
+                }
+                exit_state[x] = 2 * Count(v) + exit;
+            }
+            return (exit_state[x] & 1) != 0;
+        };
+        //a pass only fixes few vertices once the leaves are gone, so the passes stop early
+        constexpr int max_pass_num = 4;
+        rule = Alber;
+        rule_timer = goal::Timer();
+        bool timeout = false, changed = true;
+        for (int pass = 0; pass < max_pass_num && changed && !timeout; ++pass) {
+            changed = false;
+            ++alber_stats.calls;
+            for (SetId v = 0; v < vertex_num; ++v) {
+                if ((v & 255) == 0 && (global_exit_signal_reached || timer.isTimeOut())) { timeout = true; break; }
+                if (fixed.contains(v) || excluded.contains(v)) { continue; }
+                ++alber_stats.candidates;
+                Span<const SetId> row = adj[v];
+                for (SetId u : row) { mark[u] = v; }
+                for (SetId w : row) {
+                    if (dominated.contains(w)) { continue; }
+                    ++alber_stats.subset_tests;
+                    bool forced = true;
+                    for (SetId x : adj[w]) {
+                        if (x == v || excluded.contains(x)) { continue; }
+                        if (mark[x] != v || exits(x, v)) { forced = false; break; }
+                    }
+                    if (forced) { fix(v); changed = true; break; }
+                }
+            }
+        }
+        alber_stats.seconds = rule_timer.elapsedSeconds();
+
+        //the kernel: the undominated vertices are the elements, the vertices that are neither fixed nor excluded
+        //and still dominate one of them are the sets
+        Vec<ElementId> element_ids(vertex_num, -1);
+        Vec<SetId> set_ids(vertex_num, -1);
+        Vec<SetId> kept_sets;
+        Vec<ElementId> kept_elements;
+        for (SetId v = 0; v < vertex_num; ++v) {
+            if (!dominated.contains(v)) {
+                element_ids[v] = ElementId(kept_elements.size());
+                kept_elements.emplace_back(v);
+            }
+        }
+        for (SetId v = 0; v < vertex_num; ++v) {
+            if (fixed.contains(v) || excluded.contains(v)) { continue; }
+            Span<const SetId> row = adj[v];
+            if (std::any_of(row.begin(), row.end(), [&](SetId u) { return element_ids[u] >= 0; })) {
+                set_ids[v] = SetId(kept_sets.size());
+                kept_sets.emplace_back(v);
+            }
+        }
+
+        auto build_rows = [&](const Vec<SetId>& kept_rows, const Vec<SetId>& column_ids) {
+            Vec<SetId> row_sizes(kept_rows.size(), 0);
+            Vec<SetId> row_ids;
+            for (size_t r = 0; r < kept_rows.size(); ++r) {
+                for (SetId u : adj[kept_rows[r]]) {
+                    if (column_ids[u] >= 0) { row_ids.emplace_back(column_ids[u]); ++row_sizes[r]; }
+                }
+            }
+            Csr<SetId> rows;
+            rows.assign(row_sizes.data(), SetId(kept_rows.size()), row_ids.data());
+            return rows;
+        };
+        Csr<ElementId> kernel_sets = build_rows(kept_sets, element_ids);
+        Csr<SetId> kernel_elements = build_rows(kept_elements, set_ids);
+
+        //a set dropped for dominating no element any more goes to the last rule which dominated one of them,
+        //an incidence of a kept set to the rule which dominated its element
+        for (SetId v = 0; v < vertex_num; ++v) {
+            if (element_ids[v] < 0) { ++rule_stats[element_rules[v]]->removed_elements; }
+            Span<const SetId> row = adj[v];
+            if (set_ids[v] < 0) {
+                signed char r = set_rules[v];
+                if (r < 0) { for (SetId u : row) { r = std::max(r, element_rules[u]); } }
+                ++rule_stats[r]->removed_sets;
+                rule_stats[r]->removed_incidences += row.size();
+            }
+            else {
+                for (SetId u : row) {
+                    if (element_ids[u] < 0) { ++rule_stats[element_rules[u]]->removed_incidences; }
+                }
+            }
+        }
+
+        for (SetId v = 0; v < vertex_num; ++v) {
+            if (fixed.contains(v)) { ori_fixed_sets_.insert(cur_set_id_to_ori_[v]); }
+            if (set_ids[v] < 0) { ori_removed_sets_.insert(cur_set_id_to_ori_[v]); }
+            if (element_ids[v] < 0) { ori_removed_elements_.insert(cur_ele_id_to_ori_[v]); }
+        }
+        for (size_t s = 0; s < kept_sets.size(); ++s) { kept_sets[s] = cur_set_id_to_ori_[kept_sets[s]]; }
+        for (size_t e = 0; e < kept_elements.size(); ++e) { kept_elements[e] = cur_ele_id_to_ori_[kept_elements[e]]; }
+        cur_set_id_to_ori_.swap(kept_sets);
+        cur_ele_id_to_ori_.swap(kept_elements);
+
+        sets_ = std::move(kernel_sets);
+        elements_ = std::move(kernel_elements);
+        set_num_ = sets_.rowNum();
+        element_num_ = elements_.rowNum();
+
+        logger_ << "DS Kernel -> twins: " << twin_num << " | fixed by leaves (neighborhoods): " << leaf_fixed_num
+            << " (" << fixed.size() - leaf_fixed_num << ") | sets: " << set_num_ << " | elements: " << element_num_
+            << " | Time: " << timer.elapsedSeconds() << std::endl;
+    }
+}
@@ -0,0 +1,149 @@
+#include "exact_solver.h"
+#include <bit>
+#include <numeric>
+
+namespace PACE2025_HS {
+    ComponentExactSolver::ComponentExactSolver(const Vec<Vec<ElementId>>& sets, ElementId element_num)
+        : set_num_(SetId(sets.size())), element_num_(element_num), word_num_(int((element_num + 63) / 64)),
+        set_bits_(Count(set_num_) * word_num_, 0), element_sets_(element_num),
+        element_neighbors_(Count(element_num) * word_num_, 0), element_order_(element_num) {
+        for (SetId s = 0; s < set_num_; ++s) {
+            for (ElementId e : sets[s]) {
+                set_bits_[Count(s) * word_num_ + e / 64] |= Word(1) << (e % 64);
+                element_sets_[e].emplace_back(s);
+            }
+        }
+        for (ElementId e = 0; e < element_num_; ++e) {
+            Word* neighbors = &element_neighbors_[Count(e) * word_num_];
+            for (SetId s : element_sets_[e]) {
+                const Word* bits = &set_bits_[Count(s) * word_num_];
+                for (int w = 0; w < word_num_; ++w) { neighbors[w] |= bits[w]; }
+            }
+        }
+        std::iota(element_order_.begin(), element_order_.end(), 0);
+        std::stable_sort(element_order_.begin(), element_order_.end(), [&](ElementId l, ElementId r) {
+            return element_sets_[l].size() < element_sets_[r].size();
+        });
+    }
+
+    bool ComponentExactSolver::solve(Vec<SetId>& res, Count max_node_num, const goal::Timer& timer) {
+        Vec<Word> uncovered(word_num_, 0);
+        for (ElementId e = 0; e < element_num_; ++e) {
+            if (element_sets_[e].empty()) { return false; }
+            uncovered[e / 64] |= Word(1) << (e % 64);
+        }
+
+        best_ = greedy_cover(uncovered);
+        picked_.clear();
+        memo_.clear();
+        packing_buffer_.resize(word_num_);
+        node_num_ = 0;
+        max_node_num_ = max_node_num;
+        timer_ = &timer;
+        aborted_ = false;
+
+        search(uncovered);
+
+        if (aborted_) { return false; }
+        res = best_;
+        return true;
+    }
+
+    void ComponentExactSolver::search(const Vec<Word>& uncovered) {
+        if (aborted_) { return; }
+        if (++node_num_ > max_node_num_
+            || ((node_num_ & 1023) == 0 && (global_exit_signal_reached || timer_->isTimeOut()))) {
+            aborted_ = true; return;
+        }
+
+        SetId depth = SetId(picked_.size());
+        bool all_covered = std::all_of(uncovered.begin(), uncovered.end(), [](Word w) { return w == 0; });
+        if (all_covered) {
+            if (depth < SetId(best_.size())) { best_ = picked_; }
+            return;
+        }
+        //at least one more set is needed
+        if (depth + 1 >= SetId(best_.size())) { return; }
+        if (depth + packing_bound(uncovered) >= SetId(best_.size())) { return; }
+
+        //the subtree of an uncovered state has been searched from a smaller depth
+        Str key(reinterpret_cast<const char*>(uncovered.data()), uncovered.size() * sizeof(Word));
+        auto iter = memo_.find(key);
+        if (iter != memo_.end()) {
+            if (iter->second <= depth) { return; }
+            iter->second = depth;
+        }
+        else if (Count(memo_.size()) < max_memo_size) {
+            memo_.emplace(std::move(key), depth);
+        }
+
+        //branch on the uncovered element covered by the fewest sets, one of them must be picked
+        ElementId branch_e = -1;
+        for (ElementId e : element_order_) {
+            if ((uncovered[e / 64] >> (e % 64)) & 1) { branch_e = e; break; }
+        }
+
+        //try the sets covering the most uncovered elements first
+        Vec<std::pair<ElementId, SetId>> candidates;
+        for (SetId s : element_sets_[branch_e]) {
+            const Word* bits = &set_bits_[Count(s) * word_num_];
+            ElementId gain = 0;
+            for (int w = 0; w < word_num_; ++w) { gain += ElementId(std::popcount(bits[w] & uncovered[w])); }
+            candidates.emplace_back(-gain, s);
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        Vec<Word> next(word_num_);
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            SetId s = candidates[i].second;
+            const Word* bits = &set_bits_[Count(s) * word_num_];
+            //a set whose uncovered elements are all covered by an earlier candidate is never better
+            bool dominated = false;
+            for (size_t j = 0; j < i && !dominated; ++j) {
+                const Word* other = &set_bits_[Count(candidates[j].second) * word_num_];
+                dominated = true;
+                for (int w = 0; w < word_num_; ++w) {
+                    if (bits[w] & uncovered[w] & ~other[w]) { dominated = false; break; }
+                }
+            }
+            if (dominated) { continue; }
+
+            for (int w = 0; w < word_num_; ++w) { next[w] = uncovered[w] & ~bits[w]; }
+            picked_.emplace_back(s);
+            search(next);
+            picked_.pop_back();
+            if (aborted_) { return; }
+        }
+    }
+
+    SetId ComponentExactSolver::packing_bound(const Vec<Word>& uncovered) {
+        Vec<Word>& candidates = packing_buffer_;
+        std::copy(uncovered.begin(), uncovered.end(), candidates.begin());
+        SetId bound = 0;
+        for (ElementId e : element_order_) {
+            if (!((candidates[e / 64] >> (e % 64)) & 1)) { continue; }
+            ++bound;
+            const Word* neighbors = &element_neighbors_[Count(e) * word_num_];
+            for (int w = 0; w < word_num_; ++w) { candidates[w] &= ~neighbors[w]; }
+        }
+        return bound;
+    }
+
+    Vec<SetId> ComponentExactSolver::greedy_cover(Vec<Word> uncovered) const {
+        Vec<SetId> res;
+        for (;;) {
+            SetId best_s = -1; ElementId best_gain = 0;
+            for (SetId s = 0; s < set_num_; ++s) {
+                const Word* bits = &set_bits_[Count(s) * word_num_];
+                ElementId gain = 0;
+                for (int w = 0; w < word_num_; ++w) { gain += ElementId(std::popcount(bits[w] & uncovered[w])); }
+                if (gain > best_gain) { best_gain = gain; best_s = s; }
+            }
+            if (best_s < 0) { break; }
+            res.emplace_back(best_s);
+            const Word* bits = &set_bits_[Count(best_s) * word_num_];
+            for (int w = 0; w < word_num_; ++w) { uncovered[w] &= ~bits[w]; }
+        }
+        return res;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "instance.h"
+
+namespace PACE2025_HS {
+	//branch and bound for the unicost set cover of one small component.
+	//the sets and elements are renumbered to 0, 1, ... and the sets are stored as bitsets of elements.
+	struct ComponentExactSolver {
+		using Word = uint64_t;
+
+		ComponentExactSolver(const Vec<Vec<ElementId>>& sets, ElementId element_num);
+
+		//search an optimal cover within max_node_num branching nodes and before the timer runs out.
+		//return false (leaving res untouched) if the search stopped before optimality was proven.
+		bool solve(Vec<SetId>& res, Count max_node_num, const goal::Timer& timer);
+		//branching nodes visited by the last search
+		Count node_number() const { return node_num_; }
+
+	private:
+		static constexpr Count max_memo_size = 1 << 18;
+
+		void search(const Vec<Word>& uncovered);
+		//size of a set of uncovered elements no two of which are covered by the same set.
+		SetId packing_bound(const Vec<Word>& uncovered);
+		Vec<SetId> greedy_cover(Vec<Word> uncovered) const;
+
+		SetId set_num_;
+		ElementId element_num_;
+		int word_num_;
+		//the elements of set s are set_bits_[s * word_num_, (s + 1) * word_num_)
+		Vec<Word> set_bits_;
+		Vec<Vec<SetId>> element_sets_;
+		//union of the sets covering each element (same layout as set_bits_)
+		Vec<Word> element_neighbors_;
+		//elements by increasing number of covering sets
+		Vec<ElementId> element_order_;
+
+		Vec<SetId> picked_;
+		Vec<SetId> best_;
+		//smallest depth each uncovered state was reached at
+		UnorderedMap<Str, SetId> memo_;
+		Vec<Word> packing_buffer_;
+		Count node_num_ = 0;
+		Count max_node_num_ = 0;
+		const goal::Timer* timer_ = nullptr;
+		bool aborted_ = false;
+	};
+}
@@ -1,100 +1,281 @@
 #include "instance.h"
+#include "solver/tools/MappedFile.h"
+#include "solver/tools/ByteScanner.h"
+#include "solver/tools/DenseBitset.h"
+#include <atomic>
+#include <numeric>
 #include <filesystem>
+#include <thread>
 
 namespace PACE2025_HS {
     bool global_exit_signal_reached = false;
-    char global_input_line[1024 * 1024];
+    int global_thread_number = std::max(1, int(std::thread::hardware_concurrency()));
+
+    void run_in_parallel(int thread_num, const goal::Func<void(int)>& task) {
+        if (thread_num <= 1) { task(0); return; }
+        Vec<std::thread> workers; workers.reserve(thread_num - 1);
+        for (int t = 1; t < thread_num; ++t) {
+            workers.emplace_back(task, t);
+        }
+        task(0);
+        for (std::thread& worker : workers) { worker.join(); }
+    }
+
+    void run_in_parallel_blocks(int thread_num, Count item_num, Count block_size, const goal::Func<void(int, Count, Count)>& task) {
+        if (item_num <= 0) { return; }
+        Count block_num = (item_num + block_size - 1) / block_size;
+        thread_num = int(std::max<Count>(1, std::min<Count>(thread_num, block_num)));
+        std::atomic<Count> next_block(0);
+        run_in_parallel(thread_num, [&](int tid) {
+            for (Count b = next_block++; b < block_num; b = next_block++) {
+                task(tid, b * block_size, std::min(item_num, (b + 1) * block_size));
+            }
+        });
+    }
+
+
+    // Supported inputs:
+    //  - HS: PACE hitting set, "p hs n m" followed by one hyperedge per line
+    //  - DS: PACE dominating set, "p ds n m" followed by one edge "u v" per line
+    //  - DIMACS: DIMACS graph, "p edge n m" (or "p col n m") followed by edge lines "e u v", solved as dominating set
+    //  - SCP: OR-Library unicost set covering, "m n" (rows, columns), n column costs (ignored),
+    //    then for each row the number of columns covering it followed by these columns
+    enum class ProblemType { HS, DS, DIMACS, SCP };
+
+    static inline bool is_graph_problem(ProblemType prob_type) {
+        return prob_type == ProblemType::DS || prob_type == ProblemType::DIMACS;
+    }
+
+    // Detect the format from the header (skipping empty and comment lines) and read the instance size.
+    // Return false if there is no header.
+    template<typename Scanner>
+    static bool parse_header(Scanner& scanner, ProblemType& prob_type, SetId& set_num, ElementId& element_num) {
+        while (!scanner.eof()) {
+            //OR-Library files usually indent every line
+            if (scanner.peek() == ' ' || scanner.peek() == '\t' || scanner.peek() == '\r') { scanner.skip(); continue; }
+            if (goal::BufferScanner::isDigit(scanner.peek())) {
+                // OR-Library header (it may span lines)
+                ElementId m = ElementId(scanner.scanUint());
+                fatalif(!scanner.seekDigit(), "Incomplete set covering header!");
+                SetId n = SetId(scanner.scanUint());
+                prob_type = ProblemType::SCP;
+                set_num = n; element_num = m;
+                return true;
+            }
+            if (scanner.peek() != 'p') { scanner.skipLine(); continue; }
+            scanner.skip();
+            Str type_str = scanner.scanWord();
+            if (!scanner.seekDigitInLine()) { scanner.skipLine(); continue; }
+            SetId n = SetId(scanner.scanUint());
+            if (!scanner.seekDigitInLine()) { scanner.skipLine(); continue; }
+            ElementId m = ElementId(scanner.scanUint());
+            scanner.skipLine();
+
+            if (type_str == "hs") {
+                prob_type = ProblemType::HS;
+                set_num = n; element_num = m;
+            }
+            else if (type_str == "ds") {
+                prob_type = ProblemType::DS;
+                set_num = n; element_num = n;
+            }
+            else if (type_str == "edge" || type_str == "col") {
+                prob_type = ProblemType::DIMACS;
+                set_num = n; element_num = n;
+            }
+            else {
+                fatalif(true, "Problem type (%s) is not supported!", type_str.c_str());
+            }
+            return true;
+        }
+        return false;
+    }
+
+    // Incidences of a part of the body:
+    //  - HS/SCP: (hyperedge/row index inside the part, set)
+    //  - DS/DIMACS: (u, v) for each edge
+    struct ChunkIncidence {
+        Vec<std::pair<int, int>> pairs;
+        ElementId line_num = 0;
+    };
+
+    template<typename Scanner>
+    static void parse_body(Scanner& scanner, ProblemType prob_type, ChunkIncidence& chunk) {
+        while (!scanner.eof()) {
+            char c = scanner.peek();
+            // Skip empty lines
+            if (c == '\n' || c == '\r') { scanner.skip(); continue; }
+            // Skip comment lines
+            if (c == 'c') { scanner.skipLine(); continue; }
+            // Skip DIMACS lines other than edges
+            if (prob_type == ProblemType::DIMACS && c != 'e') { scanner.skipLine(); continue; }
+            if (prob_type == ProblemType::HS) {
+                // Process a set line: read all integers in the line
+                while (scanner.seekDigitInLine()) {
+                    chunk.pairs.emplace_back(chunk.line_num, int(scanner.scanUint()) - 1);
+                }
+                ++chunk.line_num;
+            }
+            else if (scanner.seekDigitInLine()) {
+                // Process an edge line
+                SetId u = SetId(scanner.scanUint()) - 1;
+                if (scanner.seekDigitInLine()) {
+                    chunk.pairs.emplace_back(u, int(scanner.scanUint()) - 1);
+                }
+            }
+            scanner.skipLine();
+        }
+    }
+
+    // The OR-Library body is a plain token stream whose rows can only be found by counting, so it is read serially
+    template<typename Scanner>
+    static void parse_scp_body(Scanner& scanner, SetId set_num, ElementId element_num, ChunkIncidence& chunk) {
+        for (SetId s = 0; s < set_num; ++s) {
+            fatalif(!scanner.seekDigit(), "Missing cost of column %d!", s + 1);
+            scanner.scanUint();
+        }
+        for (ElementId e = 0; e < element_num; ++e) {
+            fatalif(!scanner.seekDigit(), "Missing row %d!", e + 1);
+            SetId cover_n = SetId(scanner.scanUint());
+            for (SetId i = 0; i < cover_n; ++i) {
+                fatalif(!scanner.seekDigit(), "Incomplete row %d!", e + 1);
+                chunk.pairs.emplace_back(e, int(scanner.scanUint()) - 1);
+            }
+        }
+        chunk.line_num = element_num;
+    }
+
+    // Merge the parts in input order: count degrees first, then place incidences
+    static void build_adjacency(OriginalSCInstance& inst, ProblemType prob_type, Vec<ChunkIncidence>& chunks) {
+        const SetId set_num = inst.set_num_;
+        const ElementId element_num = inst.element_num_;
+        Vec<ElementId> set_degrees(set_num, 0);
+        Vec<SetId> element_degrees(element_num, 0);
+        if (!is_graph_problem(prob_type)) {
+            ElementId line_offset = 0;
+            for (const ChunkIncidence& chunk : chunks) {
+                //checked before the chunk is counted, its lines would be out of element_degrees
+                fatalif(line_offset + chunk.line_num > element_num, "Too many hyperedges (> %d)!", element_num);
+                for (const auto& [le, s] : chunk.pairs) {
+                    fatalif(s < 0 || s >= set_num, "Vertex id %d out of range!", s + 1);
+                    ++set_degrees[s];
+                    ++element_degrees[line_offset + le];
+                }
+                line_offset += chunk.line_num;
+            }
+        }
+        else {
+            std::fill(set_degrees.begin(), set_degrees.end(), 1);
+            for (const ChunkIncidence& chunk : chunks) {
+                for (const auto& [u, v] : chunk.pairs) {
+                    fatalif(u < 0 || u >= set_num || v < 0 || v >= set_num, "Edge (%d, %d) out of range!", u + 1, v + 1);
+                    ++set_degrees[u]; ++set_degrees[v];
+                }
+            }
+        }
+
+        inst.sets_.init(set_degrees);
+        inst.is_symmetric_ = false;
+        if (!is_graph_problem(prob_type)) { inst.elements_.init(element_degrees); }
+
+        if (!is_graph_problem(prob_type)) {
+            ElementId line_offset = 0;
+            for (ChunkIncidence& chunk : chunks) {
+                for (const auto& [le, s] : chunk.pairs) {
+                    inst.sets_.pushBack(s, line_offset + le);
+                    inst.elements_.pushBack(line_offset + le, s);
+                }
+                line_offset += chunk.line_num;
+                Vec<std::pair<int, int>>().swap(chunk.pairs);
+            }
+        }
+        else {
+            //the closed neighborhoods are symmetric, so one adjacency serves as both sets and elements
+            for (SetId s = 0; s < set_num; ++s) {
+                inst.sets_.pushBack(s, s);
+            }
+            for (ChunkIncidence& chunk : chunks) {
+                for (const auto& [u, v] : chunk.pairs) {
+                    inst.sets_.pushBack(u, v);
+                    inst.sets_.pushBack(v, u);
+                }
+
+                Vec<std::pair<int, int>>().swap(chunk.pairs);
+            }
+            inst.elements_ = inst.sets_;
+            inst.is_symmetric_ = true;
+        }
+    }
 
 	void OriginalSCInstance::read_hs_instance(const Str& filename) {
         std::filesystem::path p(filename);
         instname_ = p.stem().string();
 
-        FILE* file = fopen(filename.c_str(), "r");
-        if (!file) {
+        goal::MappedFile input_file;
+        if (!input_file.open(filename)) {
             fatalif(true, "Open file %s failed!", filename.c_str());
         }
-        read_hs_instance(file);
-        fclose(file); 
+        read_hs_instance(input_file.data(), input_file.size());
 	}
 
 	void OriginalSCInstance::read_hs_instance(FILE* input) {
-        bool header_processed = false; 
-        ElementId element_id = 0;
-        SetId set_id = 0;
-        enum class ProblemType { HS, DS };
+        goal::MappedFile input_file;
+        if (input_file.map(input)) {
+            read_hs_instance(input_file.data(), input_file.size());
+            return;
+        }
+
+        //pipes and terminals are parsed on the fly through a fixed window instead of being buffered whole
+        goal::StreamScanner scanner(input);
         ProblemType prob_type = ProblemType::DS;
-        while (fgets(global_input_line, sizeof(global_input_line), input)) {
-            // Skip empty lines
-            if (global_input_line[0] == '\n') continue;
-            // Skip comment lines
-            if (global_input_line[0] == 'c') continue;
-            // Process the line
-            if (!header_processed) {
-                // Read header line (p hs n m)
-                char type[3]; SetId n; ElementId m;
-
-                if (sscanf(global_input_line, "p %2s %d %d", type, &n, &m) == 3) {
-                    type[2] = 0; 
-                    if (strcmp(type, "hs") == 0) {
-                        prob_type = ProblemType::HS;
-                        set_num_ = n; sets_.resize(set_num_);
-                        element_num_ = m; elements_.resize(element_num_);
-                    }
-                    else if (strcmp(type, "ds") == 0) {
-                        prob_type = ProblemType::DS;
-                        set_num_ = n; sets_.resize(set_num_);
-                        element_num_ = n; elements_.resize(element_num_);
-                        for (SetId s = 0; s < set_num_; ++s) {
-                            sets_[s].emplace_back(s);
-                            elements_[s].emplace_back(s);
-                        }
-                    }
-                    else {
-                        fatalif(true, "Problem type (%s) != hs!", type);
-                    }
-                    header_processed = true;
-                }
-            }
-            else {
-                // Process a set line
-                char* ptr = global_input_line;
-                // Read all integers in the line
-                if (prob_type == ProblemType::HS) {
-                    while (*ptr != '\0') {
-                        if (isdigit(*ptr)) {
-                            int input_n = sscanf(ptr, "%d", &set_id);
-                            if (input_n == 1) {
-                                --set_id;
-                                sets_[set_id].emplace_back(element_id);
-                                elements_[element_id].emplace_back(set_id);
-
-                                // Move pointer past the number we just read
-                                while (isdigit(*ptr)) { ptr++; }
-                            }
-                        }
-                        else { ptr++; }
-                    }
-                    ++element_id;
-                } else {
-                    Vec<ElementId> ids;
-                    while (*ptr != '\0') {
-                        if (isdigit(*ptr)) {
-                            int input_n = sscanf(ptr, "%d", &set_id);
-                            if (input_n == 1) {
-                                ids.emplace_back(--set_id);
-                                // Move pointer past the number we just read
-                                while (isdigit(*ptr)) { ptr++; }
-                            }
-                        }
-                        else { ptr++; }
-                    }
-                    sets_[ids[0]].emplace_back(ids[1]);
-                    sets_[ids[1]].emplace_back(ids[0]);
-                    elements_[ids[0]].emplace_back(ids[1]);
-                    elements_[ids[1]].emplace_back(ids[0]);
-                }
+        if (!parse_header(scanner, prob_type, set_num_, element_num_)) { return; }
+        Vec<ChunkIncidence> chunks(1);
+        if (prob_type == ProblemType::SCP) { parse_scp_body(scanner, set_num_, element_num_, chunks[0]); }
+        else { parse_body(scanner, prob_type, chunks[0]); }
+        fatalif(scanner.failed(), "Read input failed!");
+        build_adjacency(*this, prob_type, chunks);
+	}
+
+	void OriginalSCInstance::read_hs_instance(const char* data, size_t size) {
+        //a chunk smaller than this is not worth a thread of its own
+        constexpr size_t min_chunk_size = 4 * 1024 * 1024;
+
+        const char* end = data + size;
+        goal::BufferScanner header_scanner(data, end);
+        ProblemType prob_type = ProblemType::DS;
+        if (!parse_header(header_scanner, prob_type, set_num_, element_num_)) { return; }
+        if (prob_type == ProblemType::SCP) {
+            Vec<ChunkIncidence> chunks(1);
+            parse_scp_body(header_scanner, set_num_, element_num_, chunks[0]);
+            build_adjacency(*this, prob_type, chunks);
+            return;
+        }
+        const char* ptr = header_scanner.position();
+
+        // Split the body at newline boundaries, one chunk per thread
+        size_t body_size = size_t(end - ptr);
+        int thread_num = int(std::min<size_t>(global_thread_number, body_size / min_chunk_size + 1));
+        Vec<const char*> bounds(thread_num + 1);
+        bounds[0] = ptr; bounds[thread_num] = end;
+        for (int t = 1; t < thread_num; ++t) {
+            const char* b = std::max(bounds[t - 1], ptr + body_size / thread_num * t);
+            if (b != data && b[-1] != '\n') {
+                goal::BufferScanner line_scanner(b, end);
+                line_scanner.skipLine();
+                b = line_scanner.position();
             }
+            bounds[t] = b;
         }
+
+        // Parse every chunk into thread-local incidences
+        Vec<ChunkIncidence> chunks(thread_num);
+        run_in_parallel(thread_num, [&](int t) {
+            goal::BufferScanner scanner(bounds[t], bounds[t + 1]);
+            chunks[t].pairs.reserve(size_t(bounds[t + 1] - bounds[t]) / 8);
+            parse_body(scanner, prob_type, chunks[t]);
+        });
+
+        build_adjacency(*this, prob_type, chunks);
 	}
 
     bool OriginalSCInstance::is_valid_solution(const Vec<SetId>& res) const {
@@ -114,93 +295,226 @@ namespace PACE2025_HS {
         return true;
     }
 
-    SimplifiedSCInstance::SimplifiedSCInstance(const OriginalSCInstance& inst, Log logger): osci_(inst), logger_(logger) {
-        element_num_ = osci_.element_num_;
-        set_num_ = osci_.set_num_;
-        elements_ = osci_.elements_;
-        sets_ = osci_.sets_;
-        
-        cur_set_id_to_ori_.resize(set_num_);
-        for (SetId s = 0; s < set_num_; ++s) {
-            cur_set_id_to_ori_[s] = s;
-            std::sort(sets_[s].begin(), sets_[s].end());
+    SimplifiedSCInstance::SimplifiedSCInstance(const OriginalSCInstance& inst, Log logger): logger_(logger) {
+        elements_ = inst.elements_;
+        sets_ = inst.sets_;
+        initialize_from_original(inst.element_num_, inst.set_num_, inst.is_symmetric_);
+    }
+
+    SimplifiedSCInstance::SimplifiedSCInstance(OriginalSCInstance&& inst, Log logger): logger_(logger) {
+        elements_ = std::move(inst.elements_);
+        sets_ = std::move(inst.sets_);
+        initialize_from_original(inst.element_num_, inst.set_num_, inst.is_symmetric_);
+    }
+
+    //sort every row and drop repeated ids in parallel, return the number of dropped ids.
+    //rows that are already strictly increasing are left untouched (and so is shared storage if all of them are).
+    static Count normalize_rows(Csr<int>& adj) {
+        int row_num = adj.rowNum();
+        int thread_num = std::min(global_thread_number, std::max(1, row_num / 4096));
+        Vec<Vec<int>> unsorted_rows(thread_num);
+        run_in_parallel(thread_num, [&](int tid) {
+            int begin = int(Count(row_num) * tid / thread_num), end = int(Count(row_num) * (tid + 1) / thread_num);
+            for (int r = begin; r < end; ++r) {
+                Span<const int> row = adj[r];
+                for (size_t i = 1; i < row.size(); ++i) {
+                    if (row[i - 1] >= row[i]) { unsorted_rows[tid].push_back(r); break; }
+                }
+            }
+        });
+
+        bool all_sorted = true;
+        for (const Vec<int>& rows : unsorted_rows) { all_sorted = all_sorted && rows.empty(); }
+        if (all_sorted) { return 0; }
+
+        //unshare once here, mutableRow() must not unshare concurrently
+        adj.unshare();
+        Vec<Count> removed_num(thread_num, 0);
+        run_in_parallel(thread_num, [&](int tid) {
+            for (int r : unsorted_rows[tid]) {
+                Span<int> row = adj.mutableRow(r);
+                std::sort(row.begin(), row.end());
+                int n = int(std::unique(row.begin(), row.end()) - row.begin());
+                removed_num[tid] += Count(row.size()) - n;
+                adj.resizeRow(r, n);
+            }
+        });
+
+        Count total = 0;
+        for (Count n : removed_num) { total += n; }
+        return total;
+    }
+
+    static inline void append_varint(Vec<unsigned char>& codes, unsigned int val) {
+        while (val >= 0x80) {
+            codes.push_back((unsigned char)(val | 0x80));
+            val >>= 7;
+        }
+        codes.push_back((unsigned char)val);
+    }
+
+    static inline unsigned int read_varint(const unsigned char*& ptr) {
+        unsigned int val = 0;
+        for (int shift = 0; ; shift += 7) {
+            unsigned char byte = *ptr++;
+            val |= unsigned(byte & 0x7f) << shift;
+            if (byte < 0x80) { return val; }
+        }
+    }
+
+    void SimplifiedSCInstance::initialize_from_original(ElementId ori_element_num, SetId ori_set_num, bool is_symmetric) {
+        ori_element_num_ = ori_element_num;
+        ori_set_num_ = ori_set_num;
+        //the original may only carry its sizes (see read_reduced_cache_header)
+        element_num_ = elements_.rowNum();
+        set_num_ = sets_.rowNum();
+
+        //repeated vertices in a hyperedge or repeated edges would only slow down every later scan
+        Count duplicate_num = 0;
+        is_dominating_set_ = is_symmetric;
+        if (is_symmetric) {
+            //symmetric instance: normalize the single adjacency and share it again
+            elements_ = Csr<SetId>();
+            duplicate_num += normalize_rows(sets_);
+            elements_ = sets_;
         }
+        else {
+            duplicate_num += normalize_rows(sets_);
+            duplicate_num += normalize_rows(elements_);
+        }
+        logger_ << "Removed Duplicate Incidences: " << duplicate_num << std::endl;
+
+        cur_set_id_to_ori_.resize(set_num_);
+        for (SetId s = 0; s < set_num_; ++s) { cur_set_id_to_ori_[s] = s; }
         cur_ele_id_to_ori_.resize(element_num_);
-        for (ElementId e = 0; e < element_num_; ++e) {
-            cur_ele_id_to_ori_[e] = e;
-            std::sort(elements_[e].begin(), elements_[e].end());
+        for (ElementId e = 0; e < element_num_; ++e) { cur_ele_id_to_ori_[e] = e; }
+
+        //the rows are sorted, so the gaps between consecutive elements are small
+        ori_set_codes_.clear();
+        ori_set_codes_.reserve(size_t(sets_.incidenceNum()) + set_num_);
+        ori_set_code_offsets_.assign(1, 0);
+        ori_set_code_offsets_.reserve(size_t(set_num_) + 1);
+        for (SetId s = 0; s < set_num_; ++s) {
+            ElementId prev = 0;
+            for (ElementId e : sets_[s]) {
+                append_varint(ori_set_codes_, unsigned(e - prev));
+                prev = e;
+            }
+            ori_set_code_offsets_.push_back((long long)ori_set_codes_.size());
         }
+        ori_set_codes_.shrink_to_fit();
 
         //db4(element_num_, elements_.size(), set_num_, sets_.size());
     }
 
     Vec<SetId> SimplifiedSCInstance::generate_complete_sol(const Vec<SetId>& res) const {
-        Vec<SetId> complete_res; complete_res.reserve(osci_.set_num_);
+        Vec<SetId> complete_res; complete_res.reserve(ori_set_num_);
         for (SetId s : res) {
             complete_res.emplace_back(cur_set_id_to_ori_[s]);
         }
         for (SetId s : ori_fixed_sets_) {
             complete_res.emplace_back(s);
         }
+
+        //a later fold may have merged the set of an earlier one, so the folds are undone from the last one
+        if (!fold_steps_.empty()) {
+            goal::DenseBitset picked_sets(ori_set_num_);
+            for (SetId s : complete_res) { picked_sets.insert(s); }
+            for (auto iter = fold_steps_.rbegin(); iter != fold_steps_.rend(); ++iter) {
+                SetId s = picked_sets.contains(iter->merged_set) ? iter->absorbed_set : iter->single_set;
+                if (picked_sets.insert(s)) { complete_res.emplace_back(s); }
+            }
+        }
         return complete_res;
     }
 
     bool SimplifiedSCInstance::is_valid_solution(const Vec<SetId>& res) const {
-        Vec<SetId> complete_res; complete_res.reserve(osci_.set_num_);
-        for (SetId s : res) {
-            complete_res.emplace_back(cur_set_id_to_ori_[s]);
+        return is_valid_complete_solution(generate_complete_sol(res));
+    }
+
+    bool SimplifiedSCInstance::is_valid_complete_solution(const Vec<SetId>& complete_res) const {
+        if (ori_set_code_offsets_.size() != size_t(ori_set_num_) + 1) { return false; }
+        Vec<char> is_element_covered(ori_element_num_, 0);
+        ElementId covered_num = 0;
+        for (SetId s : complete_res) {
+            if (s < 0 || s >= ori_set_num_) { return false; }
+            const unsigned char* ptr = ori_set_codes_.data() + ori_set_code_offsets_[s];
+            const unsigned char* end = ori_set_codes_.data() + ori_set_code_offsets_[s + 1];
+            ElementId e = 0;
+            while (ptr != end) {
+                e += ElementId(read_varint(ptr));
+                if (!is_element_covered[e]) {
+                    is_element_covered[e] = 1;
+                    ++covered_num;
+                }
+            }
         }
-        for (SetId s : ori_fixed_sets_) {
-            complete_res.emplace_back(s);
+
+        return covered_num == ori_element_num_;
+    }
+
+    // Lock-free union-find with link-by-index: a root is only ever linked below a smaller root,
+    // so the root of a tree is its smallest node and concurrent links cannot form a cycle.
+    static int find_root(Vec<int>& parent, int x) {
+        for (;;) {
+            int p = std::atomic_ref<int>(parent[x]).load(std::memory_order_relaxed);
+            if (p == x) { return x; }
+            int gp = std::atomic_ref<int>(parent[p]).load(std::memory_order_relaxed);
+            // path halving, losing the race only leaves a longer path
+            if (gp != p) { std::atomic_ref<int>(parent[x]).compare_exchange_weak(p, gp, std::memory_order_relaxed); }
+            x = gp;
         }
+    }
 
-        return osci_.is_valid_solution(complete_res);
+    static void unite(Vec<int>& parent, int a, int b) {
+        for (;;) {
+            a = find_root(parent, a);
+            b = find_root(parent, b);
+            if (a == b) { return; }
+            if (a < b) { std::swap(a, b); }
+            int expected = a;
+            if (std::atomic_ref<int>(parent[a]).compare_exchange_strong(expected, b, std::memory_order_relaxed)) { return; }
+        }
     }
 
     ElementId SimplifiedSCInstance::initialize_connected_component() {
-        Vec<ElementId> element_vis(element_num_, 0);
-        Vec<SetId> set_vis(set_num_, 0);
-        Vec<SetId> component_size_map(set_num_, 0);
+        // nodes [0, element_num_) are the elements, nodes [element_num_, element_num_ + set_num_) the sets
+        int node_num = element_num_ + set_num_;
+        Vec<int> parent(node_num);
+        std::iota(parent.begin(), parent.end(), 0);
+        run_in_parallel_blocks(global_thread_number, set_num_, 1024, [&](int, Count begin, Count end) {
+            for (SetId s = SetId(begin); s < SetId(end); ++s) {
+                for (ElementId e : sets_[s]) { unite(parent, element_num_ + s, e); }
+            }
+        });
 
-        element_component_id_map_.resize(element_num_);
-        set_component_id_map_.resize(set_num_);
-        set_component_size_map_.resize(set_num_);
+        // number the components by their smallest node, i.e., in the order of their first element
+        Vec<int> node_component(node_num);
         set_component_number_ = 0;
-        component_sets_.resize(set_num_);
-        component_elements_.resize(set_num_);
-        for (SetId c = 0; c < set_num_; ++c) {
-            component_sets_[c].clear();
-            component_elements_[c].clear();
+        for (int x = 0; x < node_num; ++x) {
+            int root = find_root(parent, x);
+            node_component[x] = (root == x) ? set_component_number_++ : node_component[root];
         }
 
-        for (ElementId e = 0; e < element_num_; ++e) {
-            if (element_vis[e] == 1) { continue; }
-            std::queue<ElementId> que; que.push(e);
-            element_vis[e] = true; 
-            while (!que.empty()) {
-                ElementId out = que.front(); que.pop();
-                element_component_id_map_[out] = set_component_number_;
-                component_elements_[set_component_number_].emplace_back(out);
-                for (SetId s : elements_[out]) {
-                    if (set_vis[s]) { continue; }
-                    set_vis[s] = true;
-                    for (ElementId e2 : sets_[s]) {
-                        if (element_vis[e2] == false) {
-                            que.push(e2);
-                            element_vis[e2] = true;
-                        }
-                    }
-                    component_sets_[set_component_number_].emplace_back(s);
-                    ++component_size_map[set_component_number_];
-                    set_component_id_map_[s] = set_component_number_;
-                }
-            }
-            ++set_component_number_;
-        }
+        element_component_id_map_.assign(node_component.begin(), node_component.begin() + element_num_);
+        set_component_id_map_.assign(node_component.begin() + element_num_, node_component.end());
+
+        // members grouped by component (counting sort keeps them in ascending order)
+        auto group_members = [&](const Vec<SetId>& member_component, Csr<int>& component_members) {
+            Vec<int> sizes(set_component_number_, 0);
+            for (SetId c : member_component) { ++sizes[c]; }
+            Vec<Count> offsets(set_component_number_ + 1, 0);
+            for (SetId c = 0; c < set_component_number_; ++c) { offsets[c + 1] = offsets[c] + sizes[c]; }
+            Vec<int> members(member_component.size());
+            for (int m = 0; m < int(member_component.size()); ++m) { members[offsets[member_component[m]]++] = m; }
+            component_members.assign(sizes.data(), set_component_number_, members.data());
+        };
+        group_members(set_component_id_map_, component_sets_);
+        group_members(element_component_id_map_, component_elements_);
 
+        set_component_size_map_.resize(set_num_);
         for (SetId s = 0; s < set_num_; ++s) {
-            SetId component_id = set_component_id_map_[s];
-            set_component_size_map_[s] = component_size_map[component_id];
+            set_component_size_map_[s] = component_sets_.degree(set_component_id_map_[s]);
         }
 
         return set_component_number_;
@@ -232,10 +546,10 @@ namespace PACE2025_HS {
             SetId max_2_hop_cover_n = 0, min_2_hop_cover_n = set_num_;
             Count avg_2_hop_cover_n = 0;
             for (ElementId e = 0; e < element_num_; ++e) {
-                const Vec<SetId>& E1 = elements_[e];
+                Span<const SetId> E1 = elements_[e];
                 UnorderedSet<ElementId> tow_hops;
                 for (SetId s : E1) {
-                    const Vec<SetId>& S1 = sets_[s];
+                    Span<const SetId> S1 = sets_[s];
                     for (ElementId e2 : S1) {
                         if (!tow_hops.contains(e2)) {
                             tow_hops.insert(e2);
@@ -279,10 +593,10 @@ namespace PACE2025_HS {
             SetId max_2_hop_cover_n = 0, min_2_hop_cover_n = set_num_;
             Count avg_2_hop_cover_n = 0;
             for (SetId s = 0; s < set_num_; ++s) {
-                const Vec <ElementId>& S1 = sets_[s];
+                Span<const ElementId> S1 = sets_[s];
                 UnorderedSet<SetId> tow_hops;
                 for (ElementId e : S1) {
-                    const Vec<ElementId>& E1 = elements_[e];
+                    Span<const ElementId> E1 = elements_[e];
                     for (SetId s2 : E1) {
                         if (!tow_hops.contains(s2)) {
                             tow_hops.insert(s2);
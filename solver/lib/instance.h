@@ -12,6 +12,7 @@
 #include "solver/tools/StringUtil.h"
 #include "solver/tools/ConsecutiveIdSet.h"
 #include "solver/tools/ConsecutiveIdMap.h"
+#include "solver/tools/CsrAdjacency.h"
 #include "solver/parallel_hashmap/phmap.h"
 #include "solver/parallel_hashmap/btree.h"
 #include "solver/tools/robin_hood.h"
@@ -59,6 +60,9 @@ void __dbg_impl(std::ostringstream& oss, const char* names, const T& value, cons
 
 namespace PACE2025_HS {
 	extern bool global_exit_signal_reached;
+	//number of worker threads used by the parallel stages (defaults to the hardware concurrency)
+	extern int global_thread_number;
+
 
 	/*template<typename T>
 	using PriorityQueue = goal::dary_priority_queue<4, T>;*/
@@ -78,6 +82,10 @@ namespace PACE2025_HS {
 	//phmap::flat_hash_set<ArbitraryId>;// std::unordered_set<ArbitraryId>;
 	template<typename ArbitraryId = int, typename ConsecutiveId = int>
 	using UnorderedMap = phmap::flat_hash_map<ArbitraryId, ConsecutiveId>;
+	template<typename Id = int>
+	using Csr = goal::CsrAdjacency<Id>;
+	template<typename Id = int>
+	using Span = std::span<Id>;
 
 	using Log = goal::Log;
 	using Str = std::string;
@@ -90,33 +98,89 @@ namespace PACE2025_HS {
 	static constexpr Weight MAX_WEIGHT_VALUE = Weight(1e18);
 	static constexpr Weight MIN_WEIGHT_VALUE = Weight(-1e18);
 
+	//run task(thread_index) on thread_num threads (the caller is thread 0) and wait for all of them
+	void run_in_parallel(int thread_num, const goal::Func<void(int)>& task);
+	//hand the blocks [begin, begin + block_size) of [0, item_num) out to up to thread_num threads on demand
+	//and call task(thread_index, begin, end) for each of them
+	void run_in_parallel_blocks(int thread_num, Count item_num, Count block_size, const goal::Func<void(int, Count, Count)>& task);
+
+	unsigned long long hash_input_bytes(const char* data, size_t size);
+	//whether PACE2025_HS_CACHE_DIR is set
+	bool reduction_cache_enabled();
+	//cache file of the reduced instance for the given input, empty if PACE2025_HS_CACHE_DIR is not set
+	Str reduction_cache_path(const char* data, size_t size);
+	//file the reduction rule statistics are appended to (PACE2025_HS_REDUCTION_STATS), empty if it is not set
+	Str reduction_stats_path();
+
+	//a degree-2 fold merged set absorbed_set into merged_set and removed single_set:
+	//a solution picks both merged_set and absorbed_set if it picks the merged set, otherwise single_set
+	struct FoldStep {
+		SetId single_set;
+		SetId merged_set;
+		SetId absorbed_set;
+	};
+
+	//work and yield of one reduction rule, summed over all its calls in a reduction
+	struct ReductionRuleStats {
+		const char* name = "";
+		Count calls = 0;
+		//row pairs (rows for the identity and single rules, components for the exact solver) looked at
+		Count candidates = 0;
+		//exact row comparisons (branching nodes for the exact solver)
+		Count subset_tests = 0;
+		Count removed_sets = 0;
+		Count removed_elements = 0;
+		Count removed_incidences = 0;
+		double seconds = 0;
+		bool retired = false;
+	};
+
+
 	struct OriginalSCInstance {
 		Str instname_;
-		ElementId element_num_;
-		SetId set_num_;
+		ElementId element_num_ = 0;
+		SetId set_num_ = 0;
 
 		//ÿԪЩϸ
-		Vec<Vec<SetId>> elements_;
+		Csr<SetId> elements_;
 		//ÿϿɸЩԪ
-		Vec<Vec<ElementId>> sets_;
+		Csr<ElementId> sets_;
+		//dominating set instance: elements_ and sets_ share one symmetric adjacency
+		bool is_symmetric_ = false;
 
+		//the input format (PACE hs/ds, DIMACS graph or OR-Library set covering) is detected from the header
 		void read_hs_instance(const Str& filename);
+		//regular files are mapped and parsed in parallel, other streams are parsed on the fly
 		void read_hs_instance(FILE* input);
+		void read_hs_instance(const char* data, size_t size);
+		//only take the original sizes from a reduced instance cache file (see reduction_cache.cpp)
+		bool read_reduced_cache_header(const Str& path);
+
 
 		bool is_valid_solution(const Vec<SetId>& res) const;
 	};
 
 	struct SimplifiedSCInstance {
-		const OriginalSCInstance& osci_;
 		Log logger_;
 
+		//size of the original instance
+		ElementId ori_element_num_ = 0;
+		SetId ori_set_num_ = 0;
+		//elements of every original set, delta and varint encoded, only kept to validate complete solutions.
+		//the elements of set s are in ori_set_codes_[ori_set_code_offsets_[s], ori_set_code_offsets_[s + 1])
+		Vec<unsigned char> ori_set_codes_;
+		Vec<long long> ori_set_code_offsets_;
+
 		ElementId element_num_;
 		SetId set_num_;
 
 		//ÿԪЩϸ
-		Vec<Vec<SetId>> elements_;
+		Csr<SetId> elements_;
 		//ÿϿɸЩԪ
-		Vec<Vec<ElementId>> sets_;
+		Csr<ElementId> sets_;
+
+		//dominating set instance: set s and element e are the same vertex if their original ids are equal
+		bool is_dominating_set_ = false;
 
 		double graph_density_ = 1.0;
 
@@ -138,10 +202,13 @@ namespace PACE2025_HS {
 		Vec<SetId> element_component_id_map_;
 		//set_component_size_map_[s]ʾsͨС
 		Vec<SetId> set_component_size_map_;
-		Vec<Vec<SetId>> component_sets_;
-		Vec<Vec<ElementId>> component_elements_;
+		//row c lists the sets (elements) of the c-th connected component in ascending order
+		Csr<SetId> component_sets_;
+		Csr<ElementId> component_elements_;
 
 		SimplifiedSCInstance(const OriginalSCInstance &inst, Log logger);
+		//take over the adjacency of inst, which only keeps its sizes afterwards
+		SimplifiedSCInstance(OriginalSCInstance&& inst, Log logger);
 
 		//
 		//ѡļ
@@ -154,7 +221,11 @@ namespace PACE2025_HS {
 		Vec<SetId> cur_set_id_to_ori_;
 		Vec<ElementId> cur_ele_id_to_ori_;
 
-		SetId fixed_set_number() const { return SetId(ori_fixed_sets_.size()); }
+		//postsolve stack of the degree-2 folds (see reduction.cpp) in original ids, generate_complete_sol undoes them backwards
+		Vec<FoldStep> fold_steps_;
+
+		//number of sets every complete solution has on top of the reduced one
+		SetId fixed_set_number() const { return SetId(ori_fixed_sets_.size() + fold_steps_.size()); }
 
 		ElementId initialize_connected_component() ;
 
@@ -163,11 +234,30 @@ namespace PACE2025_HS {
 		void print_statistics() const ;
 
 		void reduction(long long max_time_limit);
+		//twin, leaf and single vertex neighborhood rules of dominating set on the symmetric adjacency,
+		//the kernel replaces it as a set cover instance (see ds_kernel.cpp). the first stage of reduction()
+		void reduce_dominating_set_graph(const goal::Timer& timer,
+			ReductionRuleStats& twin_stats, ReductionRuleStats& leaf_stats, ReductionRuleStats& alber_stats);
+		//seconds of the reduction budget (rules and exact solver) left unused, the later solvers may take them
+		double reduction_time_left_ = 0;
+		//statistics of the last reduction, one entry per rule
+		Vec<ReductionRuleStats> reduction_stats_;
+		//append the statistics as one JSON object per line
+		bool save_reduction_stats(const Str& path) const;
 
 		bool try_to_initialize_hop2_neighbor(long long max_time_limit);
 
+		//store/restore the reduced instance (adjacency, id mappings, fixed sets and components)
+		bool save_reduced_instance(const Str& path) const;
+		bool load_reduced_instance(const Str& path);
+
 		Vec<SetId> generate_complete_sol(const Vec<SetId>& res) const;
 
 		bool is_valid_solution(const Vec<SetId>& res) const ;
+		//check a solution given in original set ids (e.g. from generate_complete_sol) against the original instance
+		bool is_valid_complete_solution(const Vec<SetId>& complete_res) const;
+
+	private:
+		void initialize_from_original(ElementId ori_element_num, SetId ori_set_num, bool is_symmetric);
 	};
 }
\ No newline at end of file
@@ -35,15 +35,15 @@ namespace PACE2025_HS {
 		const ElementId& element_num_;
 		const SetId& set_num_;
 		// ÿԪЩϸ
-		const Vec<Vec<SetId>>& elements_;
+		const Csr<SetId>& elements_;
 		// ÿϿɸЩԪ
-		const Vec<Vec<ElementId>>& sets_;
+		const Csr<ElementId>& sets_;
 		const SetId &set_component_number_;
 		const Vec<SetId>& set_component_id_map_;
 		const Vec<SetId>& set_component_size_map_;
 		const Vec<SetId>& element_component_id_map_;
-		const Vec<Vec<SetId>> &component_sets_;
-		const Vec<Vec<ElementId>> &component_elements_;
+		const Csr<SetId>& component_sets_;
+		const Csr<ElementId>& component_elements_;
 
 		//Ԫ뼯ϵĶھӣ!!!
 		const bool is_hop2_neighbor_initialized_;
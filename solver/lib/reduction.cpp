@@ -1,36 +1,293 @@
 #include "instance.h"
+#include "exact_solver.h"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <sstream>
 #include "solver/tools/binary_search.hpp"
+#include "solver/tools/SortedIds.h"
+#include "solver/tools/RadixSort.h"
+#include "solver/tools/DenseBitset.h"
 
 namespace PACE2025_HS {
+    //64-bit bitmask hash of the ids of a sorted row together with its size and bounds.
+    //a row can only be a subset of another one if may_be_subset() holds for their signatures.
+    //hash is a strong 64-bit hash of the whole row used to group identical rows.
+    struct RowSignature {
+        unsigned long long bits = 0;
+        unsigned long long hash = 0;
+        int min_id = 0;
+        int max_id = -1;
+        int size = 0;
+    };
+
+    //finalizer of splitmix64.
+    static inline unsigned long long mix_hash(unsigned long long h) {
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        return h ^ (h >> 31);
+    }
+
+    static inline RowSignature row_signature(Span<const int> row) {
+        RowSignature sig;
+        for (int id : row) {
+            sig.bits |= 1ULL << ((unsigned long long)id * 0x9E3779B97F4A7C15ULL >> 58);
+            sig.hash = mix_hash(sig.hash + (unsigned long long)id + 0x9E3779B97F4A7C15ULL);
+        }
+        sig.size = int(row.size());
+        if (!row.empty()) { sig.min_id = row.front(); sig.max_id = row.back(); }
+        return sig;
+    }
+
+    static inline bool may_be_subset(const RowSignature& sub, const RowSignature& sup) {
+        return sub.size <= sup.size && (sub.bits & ~sup.bits) == 0
+            && (sub.size == 0 || (sub.min_id >= sup.min_id && sub.max_id <= sup.max_id));
+    }
+
+    //the two members of a non-empty row with the shortest rows in adj (the same member twice if there is only one).
+    template<typename Adjacency>
+    static inline std::pair<int, int> two_rarest_members(Span<const int> row, const Adjacency& adj) {
+        int first = row[0], second = row[0];
+        int first_degree = adj.degree(first), second_degree = std::numeric_limits<int>::max();
+        for (size_t i = 1; i < row.size(); ++i) {
+            int id = row[i], degree = adj.degree(id);
+            if (degree < first_degree) {
+                second = first; second_degree = first_degree;
+                first = id; first_degree = degree;
+            }
+            else if (degree < second_degree) {
+                second = id; second_degree = degree;
+            }
+        }
+        return { first, second };
+    }
+
+    //visit the ids in both sorted rows in increasing order until visit returns true.
+    template<typename Visit>
+    static inline void for_each_common_id(Span<const int> a, Span<const int> b, Visit visit) {
+        if (a.size() > b.size()) { std::swap(a, b); }
+        if (a.data() == b.data()) {
+            for (int id : a) { if (visit(id)) { return; } }
+            return;
+        }
+        size_t j = 0;
+        for (int id : a) {
+            j = goal::sorted_ids_impl::gallop(b.data(), j, b.size(), id);
+            if (j == b.size()) { return; }
+            if (b[j] == id && visit(id)) { return; }
+        }
+    }
+
+    //the live rows identical to a row of changed_rows, except the one with the smallest id of each kind (in ascending order).
+    //the (hash, id) pairs of the live rows sharing a hash with a changed row are radix sorted,
+    //then every group of equal hashes is compared exactly against all its distinct rows, so collisions hide nothing.
+    template<typename Adjacency, typename IsRemoved>
+    static Vec<int> find_identical_rows(const Adjacency& adj, const Vec<RowSignature>& signatures,
+        const Vec<int>& changed_rows, IsRemoved is_removed,
+        std::atomic<Count>& candidate_number, std::atomic<Count>& comparison_number) {
+        using HashValue = unsigned long long;
+        UnorderedSet<HashValue> changed_hashes;
+        for (int r : changed_rows) {
+            if (!is_removed(r)) { changed_hashes.insert(signatures[r].hash); }
+        }
+        if (changed_hashes.empty()) { return {}; }
+
+        struct HashedRow { HashValue hash; int id; };
+        constexpr Count block_size = 4096;
+        Count row_num = Count(adj.rowNum());
+        Vec<Vec<HashedRow>> block_rows((row_num + block_size - 1) / block_size);
+        run_in_parallel_blocks(global_thread_number, row_num, block_size, [&](int, Count begin, Count end) {
+            Vec<HashedRow>& rows = block_rows[begin / block_size];
+            for (int r = int(begin); r < int(end); ++r) {
+                if (changed_hashes.contains(signatures[r].hash) && !is_removed(r)) { rows.push_back({ signatures[r].hash, r }); }
+            }
+        });
+        Vec<HashedRow> hashed_rows;
+        for (const Vec<HashedRow>& rows : block_rows) { hashed_rows.insert(hashed_rows.end(), rows.begin(), rows.end()); }
+        //stable, so the ids of a group stay in ascending order
+        goal::radixSort(hashed_rows, [](const HashedRow& hr) { return hr.hash; });
+        candidate_number += Count(hashed_rows.size());
+
+        Vec<Count> group_begins;
+        for (Count i = 0; i < Count(hashed_rows.size()); ++i) {
+            if (i == 0 || hashed_rows[i].hash != hashed_rows[i - 1].hash) { group_begins.push_back(i); }
+        }
+        group_begins.push_back(Count(hashed_rows.size()));
+
+        Vec<char> identical_flags(hashed_rows.size(), 0);
+        run_in_parallel_blocks(global_thread_number, Count(group_begins.size()) - 1, 64, [&](int, Count begin, Count end) {
+            Vec<int> distinct_rows;
+            Count comparison_num = 0;
+            for (Count g = begin; g < end; ++g) {
+                distinct_rows.clear();
+                for (Count i = group_begins[g]; i < group_begins[g + 1]; ++i) {
+                    Span<const int> row = adj[hashed_rows[i].id];
+                    bool identical = false;
+                    for (int d : distinct_rows) {
+                        ++comparison_num;
+                        if (std::equal(row.begin(), row.end(), adj[d].begin(), adj[d].end())) { identical = true; break; }
+                    }
+                    if (identical) { identical_flags[i] = 1; }
+                    else { distinct_rows.push_back(hashed_rows[i].id); }
+                }
+            }
+            comparison_number += comparison_num;
+        });
+
+        Vec<int> identical_rows;
+        for (size_t i = 0; i < hashed_rows.size(); ++i) {
+            if (identical_flags[i]) { identical_rows.push_back(hashed_rows[i].id); }
+        }
+        std::sort(identical_rows.begin(), identical_rows.end());
+        return identical_rows;
+    }
+
+    //worklist of the rows changed since a rule last examined them, every id is queued at most once.
+    struct DirtyIds {
+        Vec<char> flags;
+        Vec<int> ids;
+
+        void mark_all(int n) {
+            flags.assign(n, 1);
+            ids.resize(n);
+            std::iota(ids.begin(), ids.end(), 0);
+        }
+        void mark(int id) {
+            if (!flags[id]) { flags[id] = 1; ids.push_back(id); }
+        }
+        void mark(const Vec<int>& marked_ids) {
+            for (int id : marked_ids) { mark(id); }
+        }
+        //hand the queued ids over in increasing order and empty the queue.
+        Vec<int> take() {
+            Vec<int> taken; taken.swap(ids);
+            for (int id : taken) { flags[id] = 0; }
+            std::sort(taken.begin(), taken.end());
+            return taken;
+        }
+        //the rows listed in kept_rows (in ascending order) are renumbered to 0, 1, ...
+        void keep_rows(const Vec<int>& kept_rows) {
+            Vec<char> kept_flags(kept_rows.size(), 0);
+            ids.clear();
+            for (int r = 0; r < int(kept_rows.size()); ++r) {
+                if (flags[kept_rows[r]]) { kept_flags[r] = 1; ids.push_back(r); }
+            }
+            flags.swap(kept_flags);
+        }
+    };
+
+    enum ReductionRule { DsTwin, DsLeaf, DsAlber, SpecialDominate, SingleDominate, IdentityElement, IdentitySet, SetDominate, ElementDominate, Degree2Fold, ExactComponent, ReductionRuleNumber };
+    static constexpr const char* rule_names[ReductionRuleNumber] = {
+        "ds-twin", "ds-leaf", "ds-alber", "special-dominate", "single-dominate", "identity-element", "identity-set", "set-dominate", "element-dominate", "degree2-fold",
+        "exact-component"
+    };
+
     void SimplifiedSCInstance::reduction(long long max_time_limit) {
-        constexpr ElementId max_element_dominate_check_limit = 32;
-        constexpr SetId max_set_dominate_check_limit = 32;
+        reduction_stats_.assign(ReductionRuleNumber, ReductionRuleStats());
+        for (int r = 0; r < ReductionRuleNumber; ++r) { reduction_stats_[r].name = rule_names[r]; }
+        goal::Timer timer(max_time_limit * 1000.0);
+
+        //dominating set instances are kernelized on the graph before the two views are split.
+        //until something is removed, sets_ and elements_ are still the closed neighborhoods of the graph
+        if (is_dominating_set_ && set_num_ > 0 && ori_removed_sets_.empty() && ori_removed_elements_.empty()) {
+            reduce_dominating_set_graph(timer, reduction_stats_[DsTwin], reduction_stats_[DsLeaf], reduction_stats_[DsAlber]);
+        }
 
         //ѡļ
-        UnorderedSet<SetId> cur_fixed_sets;
+        goal::DenseBitset cur_fixed_sets(set_num_);
         //ͬʱѡԼزѡļ
-        UnorderedSet<SetId> cur_removed_sets;
+        goal::DenseBitset cur_removed_sets(set_num_);
         //ɺԸǵԪ
-        UnorderedSet<ElementId> cur_removed_elements;
-
+        goal::DenseBitset cur_removed_elements(element_num_);
+
+        //signatures of the current rows, kept up to date whenever a row changes
+        Vec<RowSignature> set_signatures, element_signatures;
+        auto compute_signatures = [&]() {
+            set_signatures.resize(set_num_);
+            element_signatures.resize(element_num_);
+            run_in_parallel_blocks(global_thread_number, set_num_, 4096, [&](int, Count begin, Count end) {
+                for (SetId s = SetId(begin); s < SetId(end); ++s) { set_signatures[s] = row_signature(sets_[s]); }
+            });
+            run_in_parallel_blocks(global_thread_number, element_num_, 4096, [&](int, Count begin, Count end) {
+                for (ElementId e = ElementId(begin); e < ElementId(end); ++e) { element_signatures[e] = row_signature(elements_[e]); }
+            });
+        };
+        compute_signatures();
+
+        //the special rules pair the set and the element of one vertex of a dominating set instance.
+        //their ids only coincide until the instance is renumbered, other instances pair equal ids.
+        Vec<ElementId> set_vertex_elements;
+        Vec<SetId> element_vertex_sets;
+        auto compute_vertex_counterparts = [&]() {
+            set_vertex_elements.assign(set_num_, -1);
+            element_vertex_sets.assign(element_num_, -1);
+            if (!is_dominating_set_) {
+                for (SetId s = 0; s < std::min<SetId>(set_num_, element_num_); ++s) {
+                    set_vertex_elements[s] = s; element_vertex_sets[s] = s;
+                }
+                return;
+            }
+            Vec<ElementId> ori_element_to_cur(ori_element_num_, -1);
+            for (ElementId e = 0; e < element_num_; ++e) { ori_element_to_cur[cur_ele_id_to_ori_[e]] = e; }
+            for (SetId s = 0; s < set_num_; ++s) {
+                ElementId e = ori_element_to_cur[cur_set_id_to_ori_[s]];
+                set_vertex_elements[s] = e;
+                if (e >= 0) { element_vertex_sets[e] = s; }
+            }
+        };
+        compute_vertex_counterparts();
+
+        //every rule only re-examines the rows queued in its worklists, a row is queued again
+        //whenever it shrinks. all rows are queued at the beginning.
+        //set rows shrink when elements are removed, element rows shrink when sets are removed.
+        DirtyIds dirty_sets_for_identity, dirty_sets_for_dominance;
+        DirtyIds dirty_elements_for_identity, dirty_elements_for_dominance, dirty_elements_for_single;
+        dirty_sets_for_identity.mark_all(set_num_);
+        dirty_sets_for_dominance.mark_all(set_num_);
+        dirty_elements_for_identity.mark_all(element_num_);
+        dirty_elements_for_dominance.mark_all(element_num_);
+        dirty_elements_for_single.mark_all(element_num_);
+
+        //work and removals so far, the rules are measured by their differences (see run_rule)
+        //incidences are counted on the set rows
+        Count removed_incidence_number = 0, removed_set_number = 0, removed_element_number = 0;
+        //row (pair) candidates and exact row tests, updated once per block by the parallel rules
+        std::atomic<Count> candidate_number(0), subset_test_number(0);
+
+        //only the rows of the sets covering a removed element (and of the elements covered
+        //by a removed set) can change.
         auto remove_dominated_elements = [&](
             const Vec<ElementId>& dominated_flags,
             const Vec<ElementId>& dominated_elements) {
             if (dominated_elements.empty()) { return; }
-            for (SetId s1 = 0; s1 < set_num_; ++s1) {
+            Vec<SetId> touched_sets;
+            for (ElementId de : dominated_elements) {
+                touched_sets.insert(touched_sets.end(), elements_[de].begin(), elements_[de].end());
+            }
+            std::sort(touched_sets.begin(), touched_sets.end());
+            touched_sets.erase(std::unique(touched_sets.begin(), touched_sets.end()), touched_sets.end());
+            for (SetId s1 : touched_sets) {
                 if (cur_removed_sets.contains(s1)) { continue; }
-                Vec<ElementId>& S1 = sets_[s1];
+                Span<ElementId> S1 = sets_.mutableRow(s1);
                 ElementId j = 0, cover_n = ElementId(S1.size());
                 for (ElementId i = 0; i < cover_n; ++i) {
                     if (!dominated_flags[S1[i]]) {
                         S1[j++] = S1[i];
                     }
                 }
-                S1.erase(S1.begin() + j, S1.end());
-                if (S1.empty()) { cur_removed_sets.insert(s1); }
+                if (j != cover_n) {
+                    removed_incidence_number += cover_n - j;
+                    sets_.resizeRow(s1, j);
+                    set_signatures[s1] = row_signature(sets_[s1]);
+                    dirty_sets_for_identity.mark(s1);
+                    dirty_sets_for_dominance.mark(s1);
+                }
+                if (j == 0 && cur_removed_sets.insert(s1)) { ++removed_set_number; }
             }
             for (ElementId de : dominated_elements) {
-                cur_removed_elements.insert(de);
+                if (cur_removed_elements.insert(de)) { ++removed_element_number; }
             }
         };
 
@@ -38,19 +295,31 @@ namespace PACE2025_HS {
             const Vec<ElementId>& dominated_flags,
             const Vec<SetId>& dominated_sets) {
             if (dominated_sets.empty()) { return; }
-            for (ElementId e1 = 0; e1 < element_num_; ++e1) {
+            Vec<ElementId> touched_elements;
+            for (SetId ds : dominated_sets) {
+                touched_elements.insert(touched_elements.end(), sets_[ds].begin(), sets_[ds].end());
+            }
+            std::sort(touched_elements.begin(), touched_elements.end());
+            touched_elements.erase(std::unique(touched_elements.begin(), touched_elements.end()), touched_elements.end());
+            for (ElementId e1 : touched_elements) {
                 if (cur_removed_elements.contains(e1)) { continue; }
-                Vec<SetId>& E1 = elements_[e1];
+                Span<SetId> E1 = elements_.mutableRow(e1);
                 SetId j = 0, cover_n = SetId(E1.size());
                 for (SetId i = 0; i < cover_n; ++i) {
                     if (!dominated_flags[E1[i]]) {
                         E1[j++] = E1[i];
                     }
                 }
-                E1.erase(E1.begin() + j, E1.end());
+                if (j != cover_n) {
+                    elements_.resizeRow(e1, j);
+                    element_signatures[e1] = row_signature(elements_[e1]);
+                    dirty_elements_for_identity.mark(e1);
+                    dirty_elements_for_dominance.mark(e1);
+                    dirty_elements_for_single.mark(e1);
+                }
             }
             for (SetId ds : dominated_sets) {
-                cur_removed_sets.insert(ds);
+                if (cur_removed_sets.insert(ds)) { ++removed_set_number; removed_incidence_number += sets_[ds].size(); }
             }
         };
 
@@ -59,7 +328,7 @@ namespace PACE2025_HS {
             Vec<ElementId> dominated_flags(element_num_, 0);
             Vec<ElementId> dominated_elements;
             for (SetId fs : fixed_sets) {
-                cur_removed_sets.insert(fs);
+                if (cur_removed_sets.insert(fs)) { ++removed_set_number; removed_incidence_number += sets_[fs].size(); }
                 cur_fixed_sets.insert(fs);
                 for (ElementId e : sets_[fs]) {
                     if (!dominated_flags[e]) {
@@ -72,86 +341,35 @@ namespace PACE2025_HS {
             remove_dominated_elements(dominated_flags, dominated_elements);
         };
 
+        //of identical rows only the one with the smallest id is kept.
         auto identity_element_reduction = [&]() {
-            auto element_identity = [&](const Vec<SetId>& E1, const Vec<SetId>& E2) {
-                if (E1.size() != E2.size()) { return false; }
-                for (auto i = 0; i < E1.size(); ++i) {
-                    if (E1[i] != E2[i]) { return false; }
-                }
-                return true;
-            };
+            Vec<ElementId> changed_elements = dirty_elements_for_identity.take();
+            if (changed_elements.empty()) { return false; }
+            Vec<ElementId> dominated_elements = find_identical_rows(elements_, element_signatures, changed_elements,
+                [&](ElementId e) { return cur_removed_elements.contains(e); }, candidate_number, subset_test_number);
 
             Vec<ElementId> dominated_flags(element_num_, 0);
-            Vec<ElementId> dominated_elements;
-            using HashValue = unsigned long long;
-            HashValue hash_base = HashValue(1000000 + 3);
-            UnorderedMap<HashValue, ElementId> hash_mp;
-            for (ElementId e1 = 0; e1 < element_num_; ++e1) {
-                if (cur_removed_elements.contains(e1)) { continue; }
-                const Vec<SetId>& E1 = elements_[e1];
-                HashValue val = 0;
-                for (SetId s : E1) {
-                    val = val * hash_base + (HashValue)s;
-                }
-                if (!hash_mp.contains(val)) {
-                    hash_mp[val] = e1;
-                }
-                else {
-                    ElementId e2 = hash_mp[val];
-                    const Vec<SetId>& E2 = elements_[e2];
-                    if (element_identity(E1, E2)) {
-                        dominated_flags[e1] = true;
-                        dominated_elements.emplace_back(e1);
-                    }
-                }
-            }
-
+            for (ElementId e : dominated_elements) { dominated_flags[e] = true; }
             remove_dominated_elements(dominated_flags, dominated_elements);
 
             return !dominated_elements.empty();
         };
 
         auto identity_set_reduction = [&]() {
-            auto set_identity = [&](const Vec<ElementId>& S1, const Vec<ElementId>& S2) {
-                if (S1.size() != S2.size()) { return false; }
-                for (auto i = 0; i < S1.size(); ++i) {
-                    if (S1[i] != S2[i]) { return false; }
-                }
-                return true;
-            };
+            Vec<SetId> changed_sets = dirty_sets_for_identity.take();
+            if (changed_sets.empty()) { return false; }
+            Vec<SetId> dominated_sets = find_identical_rows(sets_, set_signatures, changed_sets,
+                [&](SetId s) { return cur_removed_sets.contains(s); }, candidate_number, subset_test_number);
 
             Vec<SetId> dominated_flags(set_num_, 0);
-            Vec<SetId> dominated_sets;
-            using HashValue = unsigned long long;
-            HashValue hash_base = HashValue(1000000 + 3);
-            UnorderedMap<HashValue, SetId> hash_mp;
-            for (SetId s1 = 0; s1 < set_num_; ++s1) {
-                if (cur_removed_sets.contains(s1)) { continue; }
-                const Vec<ElementId>& S1 = sets_[s1];
-                HashValue val = 0;
-                for (ElementId e : S1) {
-                    val = val * hash_base + (HashValue)e;
-                }
-                if (!hash_mp.contains(val)) {
-                    hash_mp[val] = s1;
-                }
-                else {
-                    SetId s2 = hash_mp[val];
-                    const Vec<ElementId>& S2 = sets_[s2];
-                    if (set_identity(S1, S2)) {
-                        dominated_flags[s1] = true;
-                        dominated_sets.emplace_back(s1);
-                    }
-                }
-            }
-
+            for (SetId s : dominated_sets) { dominated_flags[s] = true; }
             remove_dominated_sets(dominated_flags, dominated_sets);
 
             return !dominated_sets.empty();
         };
 
         //鸲Ԫe1ļǷ֧串Ԫe2ļ
-        auto is_element_dominated = [&](const Vec<SetId>& E1, const Vec<SetId>& E2) {
+        auto is_element_dominated = [&](Span<const SetId> E1, Span<const SetId> E2) {
             if (E1.size() > E2.size()) return false;
 
             /*ElementId p1 = 0, p2 = 0;
@@ -167,89 +385,82 @@ namespace PACE2025_HS {
                 }
                 else { dominated = false; break; }
             }*/
-            if (E1.back() > E2.back()) { return false; }
-            Vec<SetId>::const_iterator iter_1 = E1.begin();
-            Vec<SetId>::const_iterator iter_2 = E2.begin();
-            bool dominated = true;
-            while (iter_1 != E1.end() && iter_2 != E2.end()) {
-                ElementId val1 = *iter_1;
-                //iter_2 = branchless_lower_bound(iter_2, E2.end(), *iter_1);
-                iter_2 = std::lower_bound(iter_2, E2.end(), val1);
-
-                if (iter_2 == E2.end() || *iter_2 != val1) {
-                    dominated = false; break;
-                }
-                else {
-                    ++iter_1; ++iter_2;
-                    if (iter_1 == E1.end()) {
-                        dominated = true; break;
-                    }
-                    if (E2.end() - iter_2 < E1.end() - iter_1) {
-                        dominated = false; break;
-                    }
-                }
-            }
-
-            return dominated;
+            return goal::isSortedSubset(E1, E2);
         };
 
+        //e2 is dominated iff some e1 (|E1| <= limit) has E1 < E2 (strict subset), or E1 == E2 and e1 < e2.
+        //the rule does not depend on the scan order, so every thread checks its own e1 and only raises flags.
+        //rows only shrink, so only the changed e1 can dominate something new.
         auto element_dominate_reduction = [&](goal::Timer& timer) {
+            Vec<ElementId> changed_elements = dirty_elements_for_dominance.take();
+            if (changed_elements.empty()) { return false; }
             Vec<ElementId> dominated_flags(element_num_, 0);
-            Vec<ElementId> dominated_elements;
-            for (ElementId e1 = 0; e1 < element_num_; ++e1) {
-                if (global_exit_signal_reached) { break; }
-                if (timer.isTimeOut()) { break; }
-
-                //e1ѾԪ֧䣬Ҫe1Ƿ֧Ԫ
-                //Ԫؿ϶Ա֧e1Ԫ֧
-                //ͬʱͬϻ֧
-                if (dominated_flags[e1]) { continue; }
-                if (cur_removed_elements.contains(e1)) { continue; }
-                const Vec<SetId>& E1 = elements_[e1];
-                if (E1.size() > max_element_dominate_check_limit) { continue; }
-
-                /*Vec<SetId> covered_sets = E1;
-                std::sort(covered_sets.begin(), covered_sets.end(), [&](SetId l, SetId r) {
-                    return sets_[l].size() < sets_[r].size();
-                });
-                Vec<ElementId> result = sets_[covered_sets[0]];
-                for (int i = 1; i < covered_sets.size(); ++i) {
-                    if (result.empty()) break; 
-                    Vec<ElementId> temp;
-                    std::set_intersection(
-                        result.begin(), result.end(),
-                        sets_[covered_sets[i]].begin(), sets_[covered_sets[i]].end(),
-                        std::back_inserter(temp)
-                    );
-                    result = std::move(temp); 
-                }
-                for (ElementId e2 : result) {
-                    if (e2 == e1) { continue; }
-                    if (!dominated_flags[e2]) {
-                        dominated_flags[e2] = true;
-                        dominated_elements.emplace_back(e2);
-                    }
-                }*/
-
-                SetId minimum_elems_set = -1; SetId min_set_count = element_num_ + 1;
-                for (SetId s : E1) {
-                    SetId set_count = (ElementId)sets_[s].size();
-                    if (min_set_count > set_count) {
-                        min_set_count = set_count;
-                        minimum_elems_set = s;
-                    }
-                }
-                const Vec<ElementId>& S1 = sets_[minimum_elems_set];
-                for (ElementId e2 : S1) {
-                    if (e2 == e1) { continue; }
-                    const Vec<SetId>& E2 = elements_[e2];
-                    //жE1ǷE2Ӽ: ǣɾe2
-                    if (dominated_flags[e2] || E1.size() > E2.size()) { continue; }
-                    if (is_element_dominated(E1, E2)) {
-                        dominated_flags[e2] = true;
-                        dominated_elements.emplace_back(e2);
+            auto flag_of = [&](ElementId e) { return std::atomic_ref<ElementId>(dominated_flags[e]); };
+            run_in_parallel_blocks(global_thread_number, Count(changed_elements.size()), 256, [&](int, Count begin, Count end) {
+                Count candidate_num = 0, test_num = 0;
+                for (Count k = begin; k < end; ++k) {
+                    ElementId e1 = changed_elements[k];
+                    if (global_exit_signal_reached) { break; }
+                    if (timer.isTimeOut()) { break; }
+
+                    //e1ѾԪ֧䣬Ҫe1Ƿ֧Ԫ
+                    //Ԫؿ϶Ա֧e1Ԫ֧
+                    //ͬʱͬϻ֧
+                    if (flag_of(e1).load(std::memory_order_relaxed)) { continue; }
+                    if (cur_removed_elements.contains(e1)) { continue; }
+                    Span<const SetId> E1 = elements_[e1];
+
+                    /*Vec<SetId> covered_sets = E1;
+                    std::sort(covered_sets.begin(), covered_sets.end(), [&](SetId l, SetId r) {
+                        return sets_[l].size() < sets_[r].size();
+                    });
+                    Vec<ElementId> result = sets_[covered_sets[0]];
+                    for (int i = 1; i < covered_sets.size(); ++i) {
+                        if (result.empty()) break; 
+                        Vec<ElementId> temp;
+                        std::set_intersection(
+                            result.begin(), result.end(),
+                            sets_[covered_sets[i]].begin(), sets_[covered_sets[i]].end(),
+                            std::back_inserter(temp)
+                        );
+                        result = std::move(temp); 
                     }
+                    for (ElementId e2 : result) {
+                        if (e2 == e1) { continue; }
+                        if (!dominated_flags[e2]) {
+                            dominated_flags[e2] = true;
+                            dominated_elements.emplace_back(e2);
+                        }
+                    }*/
+
+                    if (E1.empty()) { continue; }
+                    //every element dominated by e1 is covered by all sets of E1, in particular by its two smallest ones
+                    auto [rarest_set, second_rarest_set] = two_rarest_members(E1, sets_);
+                    for_each_common_id(sets_[rarest_set], sets_[second_rarest_set], [&](ElementId e2) {
+                        if (e2 == e1) { return false; }
+                        ++candidate_num;
+                        Span<const SetId> E2 = elements_[e2];
+                        //жE1ǷE2Ӽ: ǣɾe2
+                        if (flag_of(e2).load(std::memory_order_relaxed) || E1.size() > E2.size()) { return false; }
+                        //of two identical elements the one with the smaller id survives
+                        if (E1.size() == E2.size() && e2 < e1) { return false; }
+                        if (!may_be_subset(element_signatures[e1], element_signatures[e2])) { return false; }
+                        ++test_num;
+                        if (is_element_dominated(E1, E2)) {
+                            flag_of(e2).store(1, std::memory_order_relaxed);
+                        }
+                        return false;
+                    });
                 }
+                candidate_number += candidate_num;
+                subset_test_number += test_num;
+            });
+            //examine the rows again next time if the pass was interrupted
+            if (global_exit_signal_reached || timer.isTimeOut()) { dirty_elements_for_dominance.mark(changed_elements); }
+
+            Vec<ElementId> dominated_elements;
+            for (ElementId e = 0; e < element_num_; ++e) {
+                if (dominated_flags[e]) { dominated_elements.emplace_back(e); }
             }
 
             remove_dominated_elements(dominated_flags, dominated_elements);
@@ -258,7 +469,7 @@ namespace PACE2025_HS {
         };
         
         //鼯s1ǵԪǷ񱻼s2ǵԪ֧
-        auto is_set_dominated = [&](const Vec<ElementId>& S1, const Vec<ElementId>& S2) {
+        auto is_set_dominated = [&](Span<const ElementId> S1, Span<const ElementId> S2) {
             if (S1.size() > S2.size()) return false;
 
             /*SetId p1 = 0, p2 = 0; bool dominated = false;
@@ -278,31 +489,11 @@ namespace PACE2025_HS {
                 }
                 else { dominated = false; break; }
             }*/
-            if (S1.back() > S2.back()) { return false; }
-            if (S1.front() < S2.front()) { return false; }
-            bool dominated = false;
-            Vec<ElementId>::const_iterator iter_1 = S1.begin();
-            Vec<ElementId>::const_iterator iter_2 = S2.begin();
-            while (iter_1 != S1.end() && iter_2 != S2.end()) {
-                ElementId val1 = *iter_1;
-                iter_2 = std::lower_bound(iter_2, S2.end(), val1);
-                if (iter_2 == S2.end() || *iter_2 != val1) {
-                    dominated = false; break;
-                }
-                else {
-                    ++iter_1; ++iter_2;
-                    if (iter_1 == S1.end()) {
-                        dominated = true; break;
-                    }
-                    if (S2.end() - iter_2 < S1.end() - iter_1) {
-                        dominated = false; break;
-                    }
-                }
-            }
-            return dominated;
+            return goal::isSortedSubset(S1, S2);
         };
 
         auto special_dominate_reduction = [&](goal::Timer& timer) {
+            Count candidate_num = 0, test_num = 0;
             Vec<ElementId> dominated_element_flags(element_num_, 0);
             Vec<ElementId> dominated_elements;
             auto special_element_dominate_reduction = [&]() {
@@ -315,13 +506,18 @@ namespace PACE2025_HS {
                     //ͬʱͬϻ֧
                     if (dominated_element_flags[e1]) { continue; }
                     if (cur_removed_elements.contains(e1)) { continue; }
-                    const Vec<SetId>& E1 = elements_[e1];
-                    if (E1.size() > max_element_dominate_check_limit) { continue; }
+                    Span<const SetId> E1 = elements_[e1];
 
                     //
                     if (E1.size() <= 3) {
-                        for (SetId si : E1) {
-                            if (elements_.size() > si && si != e1 && !dominated_element_flags[si] && is_element_dominated(E1, elements_[si])) {
+                        for (SetId s : E1) {
+                            ElementId si = set_vertex_elements[s];
+                            //removed elements keep their stale rows, they must not take part
+                            if (si < 0 || si == e1 || dominated_element_flags[si] || cur_removed_elements.contains(si)) { continue; }
+                            ++candidate_num;
+                            if (!may_be_subset(element_signatures[e1], element_signatures[si])) { continue; }
+                            ++test_num;
+                            if (is_element_dominated(E1, elements_[si])) {
                                 dominated_element_flags[si] = true; dominated_elements.emplace_back(si);
                             }
                         }
@@ -341,19 +537,23 @@ namespace PACE2025_HS {
                     if (dominated_set_flags[s1]) { continue; }
                     if (cur_removed_sets.contains(s1)) { continue; }
 
-                    const Vec<ElementId>& S1 = sets_[s1];
+                    Span<const ElementId> S1 = sets_[s1];
                     if (S1.empty()) {
                         dominated_set_flags[s1] = true;
                         dominated_sets.emplace_back(s1);
                         continue;
                     }
-                    if (S1.size() > max_set_dominate_check_limit) { continue; }
 
                     //
                     if (S1.size() <= 3) {
-                        for (ElementId ei : S1) {
+                        for (ElementId e : S1) {
+                            SetId ei = element_vertex_sets[e];
                             //s2=eiѾ֧ˣҪs2֧s1 -> ڸļ֧s1, ͬʱͬϻ֧
-                            if (sets_.size() > ei && ei != s1 && !dominated_set_flags[ei] && is_set_dominated(S1, sets_[ei])) {
+                            if (ei < 0 || ei == s1 || dominated_set_flags[ei] || cur_removed_sets.contains(ei)) { continue; }
+                            ++candidate_num;
+                            if (!may_be_subset(set_signatures[s1], set_signatures[ei])) { continue; }
+                            ++test_num;
+                            if (is_set_dominated(S1, sets_[ei])) {
                                 dominated_set_flags[s1] = true; dominated_sets.emplace_back(s1); break;
                             }
                         }
@@ -363,6 +563,8 @@ namespace PACE2025_HS {
 
             special_element_dominate_reduction();
             special_set_dominate_reduction();
+            candidate_number += candidate_num;
+            subset_test_number += test_num;
 
             remove_dominated_elements(dominated_element_flags, dominated_elements);
 
@@ -371,76 +573,90 @@ namespace PACE2025_HS {
             return !dominated_elements.size() && !dominated_sets.empty();
         };
 
+        //s1 is dominated iff |S1| <= limit and S1 is empty, or some s2 has S1 < S2 (strict subset), or S1 == S2 and s2 > s1.
+        //the rule does not depend on the scan order, so every thread checks its own s1 and only raises its flag.
+        //rows only shrink, so only the changed s1 can be dominated by something new.
         auto set_dominate_reduction = [&](goal::Timer& timer) {
+            Vec<SetId> changed_sets = dirty_sets_for_dominance.take();
+            if (changed_sets.empty()) { return false; }
             Vec<SetId> dominated_flags(set_num_, 0);
-            Vec<SetId> dominated_sets;
-            for (SetId s1 = 0; s1 < set_num_; ++s1) {
-                if (global_exit_signal_reached) { break; }
-                if (timer.isTimeOut()) { break; }
+            auto flag_of = [&](SetId s) { return std::atomic_ref<SetId>(dominated_flags[s]); };
+            run_in_parallel_blocks(global_thread_number, Count(changed_sets.size()), 256, [&](int, Count begin, Count end) {
+                Count candidate_num = 0, test_num = 0;
+                for (Count k = begin; k < end; ++k) {
+                    SetId s1 = changed_sets[k];
+                    if (global_exit_signal_reached) { break; }
+                    if (timer.isTimeOut()) { break; }
 
-                //Ѿ֧䣺ҪǼs1Ƿ֧
-                if (dominated_flags[s1]) { continue; }
-                if (cur_removed_sets.contains(s1)) { continue; }
+                    //Ѿ֧䣺ҪǼs1Ƿ֧
+                    if (flag_of(s1).load(std::memory_order_relaxed)) { continue; }
+                    if (cur_removed_sets.contains(s1)) { continue; }
 
-                const Vec<ElementId>& S1 = sets_[s1];
-                if (S1.empty()) { 
-                    dominated_flags[s1] = true; 
-                    dominated_sets.emplace_back(s1);
-                    continue; 
-                }
-                if (S1.size() > max_set_dominate_check_limit) { continue; }
-
-                //Vec<ElementId> covered_elems = S1;
-                //std::sort(covered_elems.begin(), covered_elems.end(), [&](ElementId l, ElementId r) {
-                //    return elements_[l].size() < elements_[r].size();
-                //});
-                //for (SetId s2 : elements_[covered_elems[0]]) {
-                //    if (s2 == s1) { continue; }
-                //    const Vec<ElementId>& S2 = sets_[s2];
-                //    //жS1ǷS2Ӽ: ǣɾs1
-                //    //s2Ѿ֧ˣҪs2֧s1
-                //    // - ڸļ֧s1
-                //    // - ͬʱͬϻ֧
-                //    if (dominated_flags[s2] || S1.size() > S2.size()) { continue; }
-                //    bool dominated = true;
-                //    // ѡǷSԪ
-                //    for (int i = 1; i < covered_elems.size(); ++i) {
-                //        if (!std::binary_search(
-                //            elements_[covered_elems[i]].begin(),
-                //            elements_[covered_elems[i]].end(),
-                //            s2
-                //        )) { dominated = false; break; }
-                //    }
-                //    if (dominated) {
-                //        dominated_flags[s1] = true;
-                //        dominated_sets.emplace_back(s1);
-                //        break;
-                //    }
-                //}
-
-                ElementId minimum_sets_elem = -1; ElementId min_elem_count = set_num_ + 1;
-                for (ElementId e : S1) {
-                    ElementId elem_count = (ElementId)elements_[e].size();
-                    if (min_elem_count > elem_count) {
-                        min_elem_count = elem_count;
-                        minimum_sets_elem = e;
-                    }
-                }
-                const Vec<SetId>& E1 = elements_[minimum_sets_elem];
-                for (SetId s2 : E1) {
-                    if (s2 == s1) { continue; }
-                    const Vec<ElementId>& S2 = sets_[s2];
-                    //жS1ǷS2Ӽ: ǣɾs1
-                    //s2Ѿ֧ˣҪs2֧s1
-                    // - ڸļ֧s1
-                    // - ͬʱͬϻ֧
-                    if (dominated_flags[s2] || S1.size() > S2.size()) { continue; }
-                    if (is_set_dominated(S1, S2)) {
-                        dominated_flags[s1] = true;
-                        dominated_sets.emplace_back(s1);
-                        break;
+                    Span<const ElementId> S1 = sets_[s1];
+                    if (S1.empty()) { 
+                        flag_of(s1).store(1, std::memory_order_relaxed);
+                        continue; 
                     }
+
+                    //Vec<ElementId> covered_elems = S1;
+                    //std::sort(covered_elems.begin(), covered_elems.end(), [&](ElementId l, ElementId r) {
+                    //    return elements_[l].size() < elements_[r].size();
+                    //});
+                    //for (SetId s2 : elements_[covered_elems[0]]) {
+                    //    if (s2 == s1) { continue; }
+                    //    Span<const ElementId> S2 = sets_[s2];
+                    //    //жS1ǷS2Ӽ: ǣɾs1
+                    //    //s2Ѿ֧ˣҪs2֧s1
+                    //    // - ڸļ֧s1
+                    //    // - ͬʱͬϻ֧
+                    //    if (dominated_flags[s2] || S1.size() > S2.size()) { continue; }
+                    //    bool dominated = true;
+                    //    // ѡǷSԪ
+                    //    for (int i = 1; i < covered_elems.size(); ++i) {
+                    //        if (!std::binary_search(
+                    //            elements_[covered_elems[i]].begin(),
+                    //            elements_[covered_elems[i]].end(),
+                    //            s2
+                    //        )) { dominated = false; break; }
+                    //    }
+                    //    if (dominated) {
+                    //        dominated_flags[s1] = true;
+                    //        dominated_sets.emplace_back(s1);
+                    //        break;
+                    //    }
+                    //}
+
+                    //every superset of S1 contains the two elements of S1 covered by the fewest sets, only the sets covering both are candidates
+                    auto [rarest_elem, second_rarest_elem] = two_rarest_members(S1, elements_);
+                    for_each_common_id(elements_[rarest_elem], elements_[second_rarest_elem], [&](SetId s2) {
+                        if (s2 == s1) { return false; }
+                        ++candidate_num;
+                        Span<const ElementId> S2 = sets_[s2];
+                        //жS1ǷS2Ӽ: ǣɾs1
+                        //s2Ѿ֧ˣҪs2֧s1
+                        // - ڸļ֧s1
+                        // - ͬʱͬϻ֧
+                        if (flag_of(s2).load(std::memory_order_relaxed) || S1.size() > S2.size()) { return false; }
+                        //of two identical sets the one with the larger id survives
+                        if (S1.size() == S2.size() && s2 < s1) { return false; }
+                        if (!may_be_subset(set_signatures[s1], set_signatures[s2])) { return false; }
+                        ++test_num;
+                        if (is_set_dominated(S1, S2)) {
+                            flag_of(s1).store(1, std::memory_order_relaxed);
+                            return true;
+                        }
+                        return false;
+                    });
                 }
+                candidate_number += candidate_num;
+                subset_test_number += test_num;
+            });
+            //examine the rows again next time if the pass was interrupted
+            if (global_exit_signal_reached || timer.isTimeOut()) { dirty_sets_for_dominance.mark(changed_sets); }
+
+            Vec<SetId> dominated_sets;
+            for (SetId s = 0; s < set_num_; ++s) {
+                if (dominated_flags[s]) { dominated_sets.emplace_back(s); }
             }
 
             remove_dominated_sets(dominated_flags, dominated_sets);
@@ -450,7 +666,9 @@ namespace PACE2025_HS {
 
         auto single_dominate_reduction = [&]() {
             Vec<SetId> fixed_sets;
-            for (ElementId e1 = 0; e1 < element_num_; ++e1) {
+            Vec<ElementId> changed_elements = dirty_elements_for_single.take();
+            candidate_number += Count(changed_elements.size());
+            for (ElementId e1 : changed_elements) {
                 if (cur_removed_elements.contains(e1)) { continue; }
                 if (elements_[e1].size() == 1) {
                     fixed_sets.emplace_back(elements_[e1][0]);
@@ -462,107 +680,222 @@ namespace PACE2025_HS {
             return !fixed_sets.empty();
         };
 
+        //degree-2 folding (the set cover form of the vertex cover fold): if the only elements of set s are e1 and e2,
+        //covered by {s, a} and {s, b} alone, some optimal solution picks either both a and b or s alone (s next to a
+        //can be replaced by b). a and b are merged into the set a + b - {e1, e2}, kept under the id of a, which stands
+        //for picking both. s, b, e1 and e2 are removed and generate_complete_sol undoes the fold.
+        auto degree2_fold_reduction = [&]() {
+            struct Fold { SetId s, a, b; ElementId e1, e2; };
+            Vec<Fold> folds;
+            //the folds of one call share no set, so they are independent
+            goal::DenseBitset folded_sets(set_num_);
+            Count candidate_num = 0;
+            for (SetId s = 0; s < set_num_; ++s) {
+                if (cur_removed_sets.contains(s) || sets_[s].size() != 2) { continue; }
+                ++candidate_num;
+                ElementId e1 = sets_[s][0], e2 = sets_[s][1];
+                if (elements_[e1].size() != 2 || elements_[e2].size() != 2) { continue; }
+                SetId a = (elements_[e1][0] == s) ? elements_[e1][1] : elements_[e1][0];
+                SetId b = (elements_[e2][0] == s) ? elements_[e2][1] : elements_[e2][0];
+                //a == b is a set dominance
+                if (a == b || folded_sets.contains(s) || folded_sets.contains(a) || folded_sets.contains(b)) { continue; }
+                folded_sets.insert(s); folded_sets.insert(a); folded_sets.insert(b);
+                folds.push_back({ s, a, b, e1, e2 });
+            }
+            candidate_number += candidate_num;
+            if (folds.empty()) { return false; }
+
+            Vec<ElementId> merged;
+            for (const Fold& f : folds) {
+                //the merged row replaces the row of a, which moves to the end of the set rows if it does not fit
+                Span<const ElementId> A = sets_[f.a], B = sets_[f.b];
+                merged.clear();
+                std::set_union(A.begin(), A.end(), B.begin(), B.end(), std::back_inserter(merged));
+                merged.erase(std::remove_if(merged.begin(), merged.end(), [&](ElementId e) { return e == f.e1 || e == f.e2; }), merged.end());
+                removed_incidence_number += Count(sets_[f.s].size()) + A.size() + B.size() - merged.size();
+                sets_.assignRow(f.a, merged.data(), ElementId(merged.size()));
+
+                //the elements of b are covered by the merged set instead
+                for (ElementId e : sets_[f.a]) {
+                    Span<SetId> E = elements_.mutableRow(e);
+                    auto b_iter = std::lower_bound(E.begin(), E.end(), f.b);
+                    if (b_iter == E.end() || *b_iter != f.b) { continue; }
+                    if (std::binary_search(E.begin(), E.end(), f.a)) {
+                        std::copy(b_iter + 1, E.end(), b_iter);
+                        elements_.resizeRow(e, SetId(E.size()) - 1);
+                    }
+                    else {
+                        *b_iter = f.a;
+                        std::sort(E.begin(), E.end());
+                    }
+                    element_signatures[e] = row_signature(elements_[e]);
+                    dirty_elements_for_identity.mark(e);
+                    dirty_elements_for_single.mark(e);
+                    //the sets that were not below a may be below the merged set
+                    for (SetId s2 : elements_[e]) { dirty_sets_for_dominance.mark(s2); }
+                }
+                //every element of the merged set may now be dominated by another one
+                for (ElementId e : sets_[f.a]) { dirty_elements_for_dominance.mark(e); }
+                set_signatures[f.a] = row_signature(sets_[f.a]);
+                dirty_sets_for_identity.mark(f.a);
+                //the merged set lost e1, so it may be dominated even if it gained no element of b
+                dirty_sets_for_dominance.mark(f.a);
+
+                if (cur_removed_sets.insert(f.s)) { ++removed_set_number; }
+                if (cur_removed_sets.insert(f.b)) { ++removed_set_number; }
+                if (cur_removed_elements.insert(f.e1)) { ++removed_element_number; }
+                if (cur_removed_elements.insert(f.e2)) { ++removed_element_number; }
+                fold_steps_.push_back({ cur_set_id_to_ori_[f.s], cur_set_id_to_ori_[f.a], cur_set_id_to_ori_[f.b] });
+            }
+            return true;
+        };
+
         auto rebuild_instance = [&]() {
             if (cur_removed_sets.empty() && cur_removed_elements.empty()) { return; }
 
             //ɾԭʼӦӦ
-            for (SetId r_s : cur_fixed_sets) {
+            cur_fixed_sets.forEach([&](SetId r_s) {
                 ori_fixed_sets_.insert(cur_set_id_to_ori_[r_s]);
-            }
-            for (SetId r_s : cur_removed_sets) {
+            });
+            cur_removed_sets.forEach([&](SetId r_s) {
                 ori_removed_sets_.insert(cur_set_id_to_ori_[r_s]);
-            }
-            for (SetId r_e : cur_removed_elements) {
+            });
+            cur_removed_elements.forEach([&](ElementId r_e) {
                 ori_removed_elements_.insert(cur_ele_id_to_ori_[r_e]);
-            }
+            });
 
             Vec<SetId> tmp_set_id_mapper(set_num_), new_set_id_ori_mapper(set_num_);
             Vec<ElementId> tmp_ele_id_mapper1(element_num_), new_ele_id_ori_mapper(element_num_);
+            Vec<SetId> kept_sets; kept_sets.reserve(set_num_);
+            Vec<ElementId> kept_elements; kept_elements.reserve(element_num_);
 
             //ɾϲ¼idĶӦϵ
             SetId new_set_num = 0;
             for (SetId s = 0; s < set_num_; ++s) {
                 if (!cur_removed_sets.contains(s)) {
-                    sets_[new_set_num] = sets_[s];
+                    kept_sets.emplace_back(s);
                     tmp_set_id_mapper[s] = new_set_num;
                     new_set_id_ori_mapper[new_set_num] = cur_set_id_to_ori_[s];
                     new_set_num += 1;
                 }
             }
-            sets_.erase(sets_.begin() + new_set_num, sets_.end());
             set_num_ = new_set_num;
 
             //ɾԪز¼idĶӦϵ
             ElementId new_element_num = 0;
             for (ElementId e = 0; e < element_num_; ++e) {
                 if (!cur_removed_elements.contains(e)) {
-                    elements_[new_element_num] = elements_[e];
+                    kept_elements.emplace_back(e);
                     tmp_ele_id_mapper1[e] = new_element_num;
                     new_ele_id_ori_mapper[new_element_num] = cur_ele_id_to_ori_[e];
                     new_element_num += 1;
                 }
             }
-            elements_.erase(elements_.begin() + new_element_num, elements_.end());
             element_num_ = new_element_num;
 
             //¶мϽб
-            for (SetId s = 0; s < set_num_; ++s) {
-                for (ElementId& e : sets_[s]) {
-                    e = tmp_ele_id_mapper1[e];
-                }
-            }
+            sets_.keepRows(kept_sets, [&](ElementId e) { return tmp_ele_id_mapper1[e]; });
             //¶Ԫؽб
-            for (ElementId e = 0; e < element_num_; ++e) {
-                for (SetId& s : elements_[e]) {
-                    s = tmp_set_id_mapper[s];
-                }
-            }
+            elements_.keepRows(kept_elements, [&](SetId s) { return tmp_set_id_mapper[s]; });
+            //the ids changed, so do the signatures
+            compute_signatures();
+            dirty_sets_for_identity.keep_rows(kept_sets);
+            dirty_sets_for_dominance.keep_rows(kept_sets);
+            dirty_elements_for_identity.keep_rows(kept_elements);
+            dirty_elements_for_dominance.keep_rows(kept_elements);
+            dirty_elements_for_single.keep_rows(kept_elements);
 
             //µǰidԭʼidӳ
             cur_set_id_to_ori_ = new_set_id_ori_mapper;
             cur_ele_id_to_ori_ = new_ele_id_ori_mapper;
+            compute_vertex_counterparts();
 
             //յǰĻ״̬
-            cur_fixed_sets.clear();
-            cur_removed_sets.clear();
-            cur_removed_elements.clear();
+            cur_fixed_sets.reset(set_num_);
+            cur_removed_sets.reset(set_num_);
+            cur_removed_elements.reset(element_num_);
+        };
+
+        //removed sets and elements stay in place as tombstones (all rules skip them and no live row refers to them),
+        //the instance is only renumbered once they make up a large part of it.
+        constexpr double max_removed_ratio = 0.5;
+        auto rebuild_instance_if_sparse = [&]() {
+            if (cur_removed_sets.size() > set_num_ * max_removed_ratio
+                || cur_removed_elements.size() > element_num_ * max_removed_ratio) {
+                rebuild_instance();
+            }
+        };
+
+        //the rules share one time limit. a rule is retired for the rest of the reduction once one of its calls
+        //takes noticeable time (min_rule_seconds) but removes less than min_yield_ratio of the live incidences,
+        //the time it would waste goes to the later rules and to the solvers after the reduction.
+        //the exact component solver is not retired, it runs once after the other rules.
+        const double min_rule_seconds = max_time_limit * 0.01;
+        constexpr double min_yield_ratio = 0.001;
+        const Count initial_incidence_number = sets_.incidenceNum();
+        auto run_rule = [&](ReductionRule rule, auto&& apply) {
+            ReductionRuleStats& stats = reduction_stats_[rule];
+            if (stats.retired) { return false; }
+            goal::Timer rule_timer;
+            Count removed_before = removed_incidence_number;
+            Count removed_sets_before = removed_set_number, removed_elements_before = removed_element_number;
+            Count candidates_before = candidate_number, subset_tests_before = subset_test_number;
+            bool success = apply();
+            double seconds = rule_timer.elapsedSeconds();
+            Count removed = removed_incidence_number - removed_before;
+            ++stats.calls;
+            stats.candidates += candidate_number - candidates_before;
+            stats.subset_tests += subset_test_number - subset_tests_before;
+            stats.removed_sets += removed_set_number - removed_sets_before;
+            stats.removed_elements += removed_element_number - removed_elements_before;
+            stats.seconds += seconds;
+            stats.removed_incidences += removed;
+            Count live_incidence_number = initial_incidence_number - removed_incidence_number;
+            if (rule != ExactComponent && seconds > min_rule_seconds && removed < live_incidence_number * min_yield_ratio) {
+                stats.retired = true;
+                logger_ << "Retire " << rule_names[rule] << " rule: " << removed << " incidences removed in "
+                    << seconds << " s (" << removed / std::max(seconds, 1e-9) << " per second)" << std::endl;
+            }
+            return success;
         };
 
         auto reduction_ = [&](Count max_count, bool apply_element_d, goal::Timer& timer) {
             for (Count i = 0, success = 1; success > 0 && i < max_count; ++i) {
-                if (global_exit_signal_reached) { break; }
+                if (global_exit_signal_reached || timer.isTimeOut()) { break; }
 
-                if (i == 0) { 
+                if (i == 0) {
                     //for DS insatnces
-                    special_dominate_reduction(timer); 
+                    run_rule(SpecialDominate, [&]() { return special_dominate_reduction(timer); });
                 }
 
                 success = 0;
-                success += single_dominate_reduction();
-                success += identity_element_reduction();
-                success += identity_set_reduction();
-                success += set_dominate_reduction(timer);
-                success += single_dominate_reduction();
+                success += run_rule(SingleDominate, single_dominate_reduction);
+                success += run_rule(IdentityElement, identity_element_reduction);
+                success += run_rule(IdentitySet, identity_set_reduction);
+                success += run_rule(SetDominate, [&]() { return set_dominate_reduction(timer); });
+                success += run_rule(SingleDominate, single_dominate_reduction);
                 if (apply_element_d) {
-                    bool sub_succ = element_dominate_reduction(timer);
-                    if (!sub_succ) { apply_element_d = false; }
-                    success += sub_succ;
+                    success += run_rule(ElementDominate, [&]() { return element_dominate_reduction(timer); });
                 }
-                rebuild_instance();
+                success += run_rule(Degree2Fold, degree2_fold_reduction);
+                rebuild_instance_if_sparse();
 
                 Str reduction_str = StringUtil::format("Reduction #%lld -> removed elements: %zd | removed (fixed) sets : %zd (%zd)",
-                    i, ori_removed_elements_.size(), ori_removed_sets_.size(), ori_fixed_sets_.size()
+                    i, ori_removed_elements_.size() + cur_removed_elements.size(),
+                    ori_removed_sets_.size() + cur_removed_sets.size(), ori_fixed_sets_.size() + cur_fixed_sets.size()
                 );
                 logger_ << reduction_str << " | Time: " << timer.elapsedSeconds() << std::endl;
             }
             
         };
 
-        goal::Timer timer_fast(max_time_limit * 0.45 * 1000.0);
-        reduction_(20, false, timer_fast);
-
-        goal::Timer timer_slow(max_time_limit * 0.55 * 1000.0);
-        reduction_(20, true, timer_slow);
+        //the pass without element dominance runs first but may use at most first_pass_share of the limit,
+        //so the full pass always keeps the rest for element dominance, plus whatever the first pass leaves
+        constexpr double first_pass_share = 0.45;
+        goal::Timer first_pass_timer(max_time_limit * first_pass_share * 1000.0, timer.getStartTime());
+        reduction_(20, false, first_pass_timer);
+        reduction_(20, true, timer);
+        rebuild_instance();
 
         initialize_connected_component();
 
@@ -586,9 +919,13 @@ namespace PACE2025_HS {
             dbg(iter.first, iter.second);
         }*/
 
-        Vec<SetId> exact_fixed_sets = solve_small_component_and_rebuild(30);
-
-        fix_single_dominated_sets(exact_fixed_sets);
+        //the exact solver keeps its own budget of half the limit (30 s of the usual 60 s)
+        const long long component_time_limit = max_time_limit / 2;
+        run_rule(ExactComponent, [&]() {
+            Vec<SetId> exact_fixed_sets = solve_small_component_and_rebuild(component_time_limit);
+            fix_single_dominated_sets(exact_fixed_sets);
+            return !exact_fixed_sets.empty();
+        });
         rebuild_instance();
 
         initialize_connected_component();
@@ -621,6 +958,40 @@ namespace PACE2025_HS {
             graph_density_ /= set_num_; 
             graph_density_ /= element_num_;
         }
+
+        //what the rules and the exact solver did not use of their budgets goes to the solvers after the reduction
+        reduction_time_left_ = std::max(0.0, double(max_time_limit + component_time_limit) - timer.elapsedSeconds());
+
+        Str stats_path = reduction_stats_path();
+        if (!stats_path.empty() && !save_reduction_stats(stats_path)) {
+            logger_ << "Failed to write the reduction statistics to " << stats_path << std::endl;
+        }
+    }
+
+    Str reduction_stats_path() {
+        const char* stats_path = getenv("PACE2025_HS_REDUCTION_STATS");
+        return (stats_path && *stats_path) ? Str(stats_path) : Str();
+    }
+
+    bool SimplifiedSCInstance::save_reduction_stats(const Str& path) const {
+        std::ostringstream oss;
+        oss << "{\"original_sets\":" << ori_set_num_ << ",\"original_elements\":" << ori_element_num_
+            << ",\"reduced_sets\":" << set_num_ << ",\"reduced_elements\":" << element_num_
+            << ",\"fixed_sets\":" << ori_fixed_sets_.size() << ",\"folds\":" << fold_steps_.size() << ",\"rules\":[";
+        for (size_t r = 0; r < reduction_stats_.size(); ++r) {
+            const ReductionRuleStats& stats = reduction_stats_[r];
+            oss << (r > 0 ? "," : "") << "{\"name\":\"" << stats.name << "\",\"calls\":" << stats.calls
+                << ",\"candidates\":" << stats.candidates << ",\"subset_tests\":" << stats.subset_tests
+                << ",\"removed_sets\":" << stats.removed_sets << ",\"removed_elements\":" << stats.removed_elements
+                << ",\"removed_incidences\":" << stats.removed_incidences << ",\"seconds\":" << stats.seconds
+                << ",\"retired\":" << (stats.retired ? "true" : "false") << "}";
+        }
+        oss << "]}\n";
+
+        std::ofstream ofs(path, std::ios::app);
+        if (!ofs) { return false; }
+        ofs << oss.str();
+        return bool(ofs);
     }
 
     bool SimplifiedSCInstance::try_to_initialize_hop2_neighbor(long long max_time_limit) {
@@ -667,10 +1038,10 @@ namespace PACE2025_HS {
         for (ElementId e = 0; e < element_num_; ++e) {
             if (global_exit_signal_reached ||  timer.isTimeOut()) { return false; }
 
-            const Vec<SetId>& E1 = elements_[e];
+            Span<const SetId> E1 = elements_[e];
             adj2_elements.clear(true);
             for (SetId s : E1) {
-                const Vec<SetId>& S1 = sets_[s];
+                Span<const SetId> S1 = sets_[s];
                 for (ElementId e2 : S1) {
                     if (e2 != e && !adj2_elements.isItemExist(e2)) {
                         adj2_elements.insert(e2);
@@ -685,10 +1056,10 @@ namespace PACE2025_HS {
         for (SetId s = 0; s < set_num_; ++s) {
             if (global_exit_signal_reached || timer.isTimeOut()) { return false; }
 
-            const Vec <ElementId>& S1 = sets_[s];
+            Span<const ElementId> S1 = sets_[s];
             adj2_sets.clear(true);
             for (ElementId e : S1) {
-                const Vec<ElementId>& E1 = elements_[e];
+                Span<const ElementId> E1 = elements_[e];
                 for (SetId s2 : E1) {
                     if (s2 != s && !adj2_sets.isItemExist(s2)) {
                         adj2_sets.insert(s2);
@@ -703,83 +1074,74 @@ namespace PACE2025_HS {
 
 
     Vec<SetId> SimplifiedSCInstance::solve_small_component_and_rebuild(long long max_time_limit) {
-        constexpr SetId max_exact_solver_number = 22;
+        constexpr SetId max_exact_solver_number = 512;
+        constexpr ElementId max_exact_element_number = 1024;
+        constexpr Count max_exact_node_number = 1 << 16;
 
-        auto solve_one_component = [&](SetId component_id) {
-            const Vec<SetId>& set_ids = component_sets_[component_id];
-            const SetId set_num = set_ids.size();
-            if (set_num > max_exact_solver_number) { return Vec<SetId>(); }
-
-            // ѹԪر
-            UnorderedMap<ElementId, ElementId> element_to_index;
-            ElementId index_mapped = 0;
-            for (const SetId& s : set_ids) {
-                const Vec<ElementId>& si = sets_[s];
-                for (ElementId e : si) {
-                    if (!element_to_index.contains(e)) {
-                        element_to_index[e] = index_mapped++;
-                    }
-                }
-            }
+        goal::Timer timer(max_time_limit * 1000.0);
 
-            const ElementId element_num = index_mapped;
-            if (element_num > 32) { return Vec<SetId>(); }
+        std::atomic<Count> candidate_component_number(0), search_node_number(0);
+        //element_to_index maps the elements of the component to 0, 1, ... (it is -1 elsewhere and is reset before returning).
+        auto solve_one_component = [&](SetId component_id, Vec<ElementId>& element_to_index) {
+            Span<const SetId> set_ids = component_sets_[component_id];
+            const SetId set_num = set_ids.size();
 
-            using Mask = uint64_t; Vec<Mask> set_masks(set_num);
-            const Mask FULL_MASK = (Mask(1) << element_num) - 1;
-            for (SetId i = 0; i < set_num; ++i) {
-                SetId s = set_ids[i]; Mask mask = 0;
+            ++candidate_component_number;
+            Vec<ElementId> component_elements;
+            for (SetId s : set_ids) {
                 for (ElementId e : sets_[s]) {
-                    mask |= Mask(1) << element_to_index[e];
+                    if (element_to_index[e] < 0) {
+                        element_to_index[e] = ElementId(component_elements.size());
+                        component_elements.emplace_back(e);
+                    }
                 }
-                set_masks[i] = mask;
-
-                if (mask == FULL_MASK) { return Vec<SetId>({ s }); }
             }
 
-            SetId best_count = std::numeric_limits<SetId>::max(); Vec<SetId> best_res;
-            goal::Func<void(SetId, Mask, Vec<SetId>&)> dfs =
-                [&](SetId idx, Mask cover_mask, Vec<SetId>& picked) {
-                if (cover_mask == FULL_MASK) {
-                    if ((SetId)picked.size() < best_count) {
-                        best_count = picked.size(); best_res = picked;
-                    }
-                    return;
+            Vec<SetId> local_res, res;
+            const ElementId element_num = ElementId(component_elements.size());
+            if (element_num <= max_exact_element_number) {
+                Vec<Vec<ElementId>> local_sets(set_num);
+                for (SetId i = 0; i < set_num; ++i) {
+                    for (ElementId e : sets_[set_ids[i]]) { local_sets[i].emplace_back(element_to_index[e]); }
                 }
+                ComponentExactSolver solver(local_sets, element_num);
+                if (solver.solve(local_res, max_exact_node_number, timer)) {
+                    for (SetId i : local_res) { res.emplace_back(set_ids[i]); }
+                }
+                search_node_number += solver.node_number();
+            }
 
-                //ѵˣ߲ٸĽ
-                if (idx == set_num || (SetId)picked.size() >= best_count) return;
-                //ϸǵѾųΪ
-                if (best_count == 2) { return; }
-                // ѡ sets[idx]
-                dfs(idx + 1, cover_mask, picked);
-
-                // ѡ sets[idx]
-                picked.push_back(set_ids[idx]);
-                dfs(idx + 1, cover_mask | set_masks[idx], picked);
-                picked.pop_back();
-            };
-
-            Vec<SetId> path; path.reserve(set_num);
-            dfs(0, Mask(0), path);
-
-            return best_res;
+            for (ElementId e : component_elements) { element_to_index[e] = -1; }
+            return res;
         };
 
-        Vec<std::pair<SetId, SetId>> comp_set_size(set_component_number_);
+        //the components are independent: the threads take them one by one, largest first so that
+        //the long searches start early and the small ones fill the rest of the shared time limit.
+        Vec<SetId> candidate_components;
         for (SetId c = 0; c < set_component_number_; ++c) {
-            SetId set_num = (SetId)component_sets_[c].size();
-            comp_set_size[c] = std::make_pair(set_num, c);
+            if ((SetId)component_sets_[c].size() <= max_exact_solver_number) { candidate_components.emplace_back(c); }
         }
-        std::sort(comp_set_size.begin(), comp_set_size.end());
+        std::stable_sort(candidate_components.begin(), candidate_components.end(), [&](SetId l, SetId r) {
+            return component_sets_[l].size() > component_sets_[r].size();
+        });
+
+        Vec<Vec<SetId>> component_res(candidate_components.size());
+        std::atomic<Count> next_component(0);
+        run_in_parallel(global_thread_number, [&](int) {
+            Vec<ElementId> element_to_index(element_num_, -1);
+            for (Count k = next_component++; k < Count(candidate_components.size()); k = next_component++) {
+                if (global_exit_signal_reached || timer.isTimeOut()) { break; }
+                component_res[k] = solve_one_component(candidate_components[k], element_to_index);
+            }
+        });
 
-        goal::Timer timer(max_time_limit * 1000.0);
         Vec<SetId> fixed_sets; fixed_sets.reserve(set_num_);
-        for (SetId c = 0; c < set_component_number_; ++c) {
-            if (global_exit_signal_reached || timer.isTimeOut()) { break; }
-            if (comp_set_size[c].first > max_exact_solver_number) { break; }
-            Vec<SetId> res = solve_one_component(comp_set_size[c].second);
-            if (!res.empty()) { for (SetId s : res) fixed_sets.emplace_back(s); }
+        for (const Vec<SetId>& res : component_res) {
+            fixed_sets.insert(fixed_sets.end(), res.begin(), res.end());
+        }
+        if (ExactComponent < Count(reduction_stats_.size())) {
+            reduction_stats_[ExactComponent].candidates += candidate_component_number;
+            reduction_stats_[ExactComponent].subset_tests += search_node_number;
         }
 
         return fixed_sets;
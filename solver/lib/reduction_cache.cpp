@@ -0,0 +1,211 @@
+#include "instance.h"
+#include "solver/tools/MappedFile.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace PACE2025_HS {
+    // Layout of a reduced instance cache file:
+    //  - ReducedCacheHeader
+    //  - a sequence of arrays, each stored as a uint64_t item count followed by the raw items,
+    //    in the order used by save_reduced_instance()/load_reduced_instance().
+    // Bump REDUCED_CACHE_VERSION whenever the layout or the reduction rules change.
+    static constexpr char REDUCED_CACHE_MAGIC[8] = { 'P', 'A', 'C', 'E', 'H', 'S', 'R', 'C' };
+    static constexpr uint32_t REDUCED_CACHE_VERSION = 5;
+
+    struct ReducedCacheHeader {
+        char magic_[8];
+        uint32_t version_;
+        uint32_t id_bytes_;
+        int32_t ori_element_num_;
+        int32_t ori_set_num_;
+    };
+
+    unsigned long long hash_input_bytes(const char* data, size_t size) {
+        constexpr uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+        uint64_t h = prime1 ^ uint64_t(size);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t w; memcpy(&w, data + i, 8);
+            h ^= w * prime2;
+            h = ((h << 31) | (h >> 33)) * prime1;
+        }
+        //an empty input may come without a buffer
+        uint64_t tail = 0;
+        if (size > i) { memcpy(&tail, data + i, size - i); }
+        h ^= tail * prime2;
+        h ^= h >> 33; h *= prime2;
+        h ^= h >> 29; h *= prime1;
+        h ^= h >> 32;
+        return h;
+    }
+
+    bool reduction_cache_enabled() {
+        const char* cache_dir = getenv("PACE2025_HS_CACHE_DIR");
+        return cache_dir && *cache_dir;
+    }
+
+    Str reduction_cache_path(const char* data, size_t size) {
+        if (!reduction_cache_enabled()) { return Str(); }
+        const char* cache_dir = getenv("PACE2025_HS_CACHE_DIR");
+        return StringUtil::format("%s/%016llx-%llu.rsc", cache_dir, hash_input_bytes(data, size), (unsigned long long)size);
+    }
+
+    // Read the arrays of a cache file in order, every read is bounds-checked.
+    struct ReducedCacheReader {
+        const char* ptr_;
+        const char* end_;
+        bool ok_ = true;
+
+        template<typename T>
+        const T* read_array(uint64_t& n) {
+            n = 0;
+            if (!ok_ || size_t(end_ - ptr_) < sizeof(uint64_t)) { ok_ = false; return nullptr; }
+            memcpy(&n, ptr_, sizeof(uint64_t)); ptr_ += sizeof(uint64_t);
+            if (n > size_t(end_ - ptr_) / sizeof(T)) { ok_ = false; n = 0; return nullptr; }
+            const T* items = reinterpret_cast<const T*>(ptr_);
+            ptr_ += n * sizeof(T);
+            return items;
+        }
+
+        template<typename T>
+        Vec<T> read_vec() {
+            uint64_t n; const T* items = read_array<T>(n);
+            Vec<T> res(n);
+            if (n > 0) { memcpy(res.data(), items, n * sizeof(T)); }
+            return res;
+        }
+    };
+
+    static bool parse_reduced_cache_header(const goal::MappedFile& file, ReducedCacheHeader& header) {
+        if (file.size() < sizeof(ReducedCacheHeader)) { return false; }
+        memcpy(&header, file.data(), sizeof(ReducedCacheHeader));
+        return memcmp(header.magic_, REDUCED_CACHE_MAGIC, sizeof(REDUCED_CACHE_MAGIC)) == 0
+            && header.version_ == REDUCED_CACHE_VERSION
+            && header.id_bytes_ == sizeof(SetId);
+    }
+
+    bool OriginalSCInstance::read_reduced_cache_header(const Str& path) {
+        goal::MappedFile file;
+        ReducedCacheHeader header;
+        if (!file.open(path) || !parse_reduced_cache_header(file, header)) { return false; }
+        element_num_ = header.ori_element_num_;
+        set_num_ = header.ori_set_num_;
+        elements_.clear();
+        sets_.clear();
+        return true;
+    }
+
+    bool SimplifiedSCInstance::save_reduced_instance(const Str& path) const {
+        Str tmp_path = path + ".tmp";
+        FILE* fp = fopen(tmp_path.c_str(), "wb");
+        if (!fp) { return false; }
+
+        ReducedCacheHeader header;
+        memcpy(header.magic_, REDUCED_CACHE_MAGIC, sizeof(REDUCED_CACHE_MAGIC));
+        header.version_ = REDUCED_CACHE_VERSION;
+        header.id_bytes_ = sizeof(SetId);
+        header.ori_element_num_ = ori_element_num_;
+        header.ori_set_num_ = ori_set_num_;
+        bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+
+        auto write_array = [&](const auto* items, uint64_t n) {
+            ok = ok && fwrite(&n, sizeof(n), 1, fp) == 1;
+            ok = ok && (n == 0 || fwrite(items, sizeof(*items), n, fp) == n);
+        };
+        auto write_vec = [&](const auto& items) { write_array(items.data(), items.size()); };
+        auto write_set = [&](const UnorderedSet<SetId>& items) {
+            Vec<SetId> sorted_items(items.begin(), items.end());
+            std::sort(sorted_items.begin(), sorted_items.end());
+            write_vec(sorted_items);
+        };
+        auto write_csr = [&](const Csr<int>& adj) {
+            Vec<int> sizes(adj.rowNum()), ids; ids.reserve(adj.incidenceNum());
+            for (int r = 0; r < adj.rowNum(); ++r) {
+                sizes[r] = adj.degree(r);
+                ids.insert(ids.end(), adj[r].begin(), adj[r].end());
+            }
+            write_vec(sizes); write_vec(ids);
+        };
+        int32_t nums[3] = { element_num_, set_num_, set_component_number_ };
+        write_array(nums, 3);
+        write_array(&graph_density_, 1);
+        write_csr(elements_);
+        write_csr(sets_);
+        write_vec(cur_set_id_to_ori_);
+        write_vec(cur_ele_id_to_ori_);
+        write_set(ori_fixed_sets_);
+        write_set(ori_removed_sets_);
+        write_set(ori_removed_elements_);
+        write_vec(fold_steps_);
+        write_vec(set_component_id_map_);
+        write_vec(element_component_id_map_);
+        write_vec(set_component_size_map_);
+        write_csr(component_sets_);
+        write_csr(component_elements_);
+        write_vec(ori_set_codes_);
+        write_vec(ori_set_code_offsets_);
+
+        ok = (fclose(fp) == 0) && ok;
+        if (!ok || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool SimplifiedSCInstance::load_reduced_instance(const Str& path) {
+        goal::MappedFile file;
+        ReducedCacheHeader header;
+        if (!file.open(path) || !parse_reduced_cache_header(file, header)) { return false; }
+
+        ReducedCacheReader reader{ file.data() + sizeof(ReducedCacheHeader), file.data() + file.size() };
+        uint64_t n = 0, m = 0;
+        const int32_t* nums = reader.read_array<int32_t>(n);
+        if (n != 3) { return false; }
+        Vec<double> density = reader.read_vec<double>();
+        if (density.size() != 1) { return false; }
+
+        auto read_csr = [&](Csr<int>& adj, int row_num) {
+            const int* sizes = reader.read_array<int>(n);
+            const int* ids = reader.read_array<int>(m);
+            if (!reader.ok_ || n != uint64_t(row_num)) { reader.ok_ = false; return; }
+            uint64_t total = 0;
+            for (uint64_t r = 0; r < n; ++r) { total += uint64_t(sizes[r]); }
+            if (total != m) { reader.ok_ = false; return; }
+            adj.assign(sizes, row_num, ids);
+        };
+        auto read_set = [&](UnorderedSet<SetId>& items) {
+            Vec<SetId> sorted_items = reader.read_vec<SetId>();
+            items.clear();
+            items.insert(sorted_items.begin(), sorted_items.end());
+        };
+
+        element_num_ = nums[0];
+        set_num_ = nums[1];
+        set_component_number_ = nums[2];
+        graph_density_ = density[0];
+        read_csr(elements_, element_num_);
+        read_csr(sets_, set_num_);
+        cur_set_id_to_ori_ = reader.read_vec<SetId>();
+        cur_ele_id_to_ori_ = reader.read_vec<ElementId>();
+        read_set(ori_fixed_sets_);
+        read_set(ori_removed_sets_);
+        read_set(ori_removed_elements_);
+        fold_steps_ = reader.read_vec<FoldStep>();
+        set_component_id_map_ = reader.read_vec<SetId>();
+        element_component_id_map_ = reader.read_vec<SetId>();
+        set_component_size_map_ = reader.read_vec<SetId>();
+        read_csr(component_sets_, set_component_number_);
+        read_csr(component_elements_, set_component_number_);
+        ori_element_num_ = header.ori_element_num_;
+        ori_set_num_ = header.ori_set_num_;
+        ori_set_codes_ = reader.read_vec<unsigned char>();
+        ori_set_code_offsets_ = reader.read_vec<long long>();
+        if (ori_set_code_offsets_.size() != size_t(ori_set_num_) + 1
+            || uint64_t(ori_set_code_offsets_.back()) != ori_set_codes_.size()) { return false; }
+
+        return reader.ok_;
+    }
+}
@@ -0,0 +1,165 @@
+////////////////////////////////
+/// usage : 1.	line-oriented scanners for plain text inputs (unsigned integers, words and lines).
+///             `BufferScanner` walks a byte range in memory (e.g. a `MappedFile`),
+///             `StreamScanner` reads a FILE* through a fixed-size window.
+///         2.	both share the same interface, so a parser can be written once as a template.
+///
+/// note  : 1.	tokens and lines may be arbitrarily long, the stream scanner stitches them
+///             across window refills without buffering a whole line.
+///         2.	`peek()` and `skip()` are only valid after `eof()` returned false.
+////////////////////////////////
+
+#ifndef CN_HUST_GOAL_COMMON_BYTE_SCANNER_H
+#define CN_HUST_GOAL_COMMON_BYTE_SCANNER_H
+
+
+#include <cstdio>
+#include <cstring>
+
+#include "./Typedef.h"
+
+
+namespace goal {
+
+class BufferScanner {
+public:
+    BufferScanner(const char* begin, const char* end) : cur(begin), end(end) {}
+
+
+    bool eof() const { return cur == end; }
+    char peek() const { return *cur; }
+    void skip() { ++cur; }
+    const char* position() const { return cur; }
+
+    // move to the next digit of the current line.
+    // return false (stopping at the '\n' or the end) if the line has no more digits.
+    bool seekDigitInLine() {
+        while (cur != end && !isDigit(*cur)) {
+            if (*cur == '\n') { return false; }
+            ++cur;
+        }
+        return cur != end;
+    }
+
+    // move to the next digit, across lines. return false at the end.
+    bool seekDigit() {
+        while (cur != end && !isDigit(*cur)) { ++cur; }
+        return cur != end;
+    }
+
+    unsigned scanUint() {
+        unsigned val = 0;
+        while (cur != end && isDigit(*cur)) { val = val * 10 + unsigned(*cur++ - '0'); }
+        return val;
+    }
+
+    // read the word (up to the next blank or control character) after the leading spaces and tabs.
+    Str scanWord() {
+        while (cur != end && (*cur == ' ' || *cur == '\t')) { ++cur; }
+        const char* begin = cur;
+        while (cur != end && *cur > ' ') { ++cur; }
+        return Str(begin, cur);
+    }
+
+    // move to the beginning of the next line.
+    void skipLine() {
+        const char* nl = (cur == end) ? nullptr : sCast<const char*>(memchr(cur, '\n', sCast<size_t>(end - cur)));
+        cur = nl ? nl + 1 : end;
+    }
+
+    static bool isDigit(char c) { return sCast<unsigned char>(c - '0') < 10; }
+
+protected:
+    const char* cur;
+    const char* end;
+};
+
+
+class StreamScanner {
+public:
+    static constexpr size_t DefaultWindowSize = 1024 * 1024;
+
+
+    StreamScanner(FILE* input, size_t windowSize = DefaultWindowSize) : input(input), window(windowSize) {}
+
+
+    bool eof() { return (cur == end) && !refill(); }
+    char peek() const { return *cur; }
+    void skip() { ++cur; }
+    bool failed() const { return ferror(input) != 0; }
+
+    // move to the next digit of the current line.
+    // return false (stopping at the '\n' or the end) if the line has no more digits.
+    bool seekDigitInLine() {
+        for (;;) {
+            while (cur != end && !BufferScanner::isDigit(*cur)) {
+                if (*cur == '\n') { return false; }
+                ++cur;
+            }
+            if (cur != end) { return true; }
+            if (!refill()) { return false; }
+        }
+    }
+
+    // move to the next digit, across lines. return false at the end.
+    bool seekDigit() {
+        for (;;) {
+            while (cur != end && !BufferScanner::isDigit(*cur)) { ++cur; }
+            if (cur != end) { return true; }
+            if (!refill()) { return false; }
+        }
+    }
+
+    unsigned scanUint() {
+        unsigned val = 0;
+        for (;;) {
+            while (cur != end && BufferScanner::isDigit(*cur)) { val = val * 10 + unsigned(*cur++ - '0'); }
+            if (cur != end || !refill()) { return val; }
+        }
+    }
+
+    // read the word (up to the next blank or control character) after the leading spaces and tabs.
+    Str scanWord() {
+        for (;;) {
+            while (cur != end && (*cur == ' ' || *cur == '\t')) { ++cur; }
+            if (cur != end || !refill()) { break; }
+        }
+        Str word;
+        for (;;) {
+            const char* begin = cur;
+            while (cur != end && *cur > ' ') { ++cur; }
+            word.append(begin, cur);
+            if (cur != end || !refill()) { return word; }
+        }
+    }
+
+    // move to the beginning of the next line.
+    void skipLine() {
+        for (;;) {
+            const char* nl = (cur == end) ? nullptr : sCast<const char*>(memchr(cur, '\n', sCast<size_t>(end - cur)));
+            if (nl) { cur = nl + 1; return; }
+            cur = end;
+            if (!refill()) { return; }
+        }
+    }
+
+protected:
+    // replace the consumed window by the next bytes of the stream.
+    bool refill() {
+        size_t n = fread(window.data(), 1, window.size(), input);
+        cur = window.data();
+        end = cur + n;
+        return n > 0;
+    }
+
+
+    FILE* input;
+    Vec<char> window;
+    const char* cur = nullptr;
+    const char* end = nullptr;
+};
+
+}
+
+
+#endif // CN_HUST_GOAL_COMMON_BYTE_SCANNER_H
@@ -0,0 +1,222 @@
+////////////////////////////////
+/// usage : 1.	compressed sparse row (CSR) adjacency: all rows share one contiguous id array.
+///             row i occupies ids[offsets[i], offsets[i] + sizes[i]) and may shrink in place.
+///         2.	build it with `init(capacities)` followed by `pushBack(row, id)`.
+///         3.	copies share the same storage until one of them is modified (copy-on-write),
+///             so an adjacency can serve as two views (e.g. sets and elements of a symmetric
+///             instance) without being duplicated.
+///
+/// note  : 1.	rows never grow beyond the capacity given in `init()`, except through `assignRow()`
+///             which moves a row that no longer fits to the end of the id array.
+///         2.	`keepRows()` drops rows and compacts the id array (in place unless a row was moved).
+///         3.	`operator[]` is read-only, write through `mutableRow()` which unshares the storage.
+///         4.	the storage is not unshared atomically, do not modify copies concurrently.
+////////////////////////////////
+
+#ifndef CN_HUST_GOAL_COMMON_CSR_ADJACENCY_H
+#define CN_HUST_GOAL_COMMON_CSR_ADJACENCY_H
+
+
+#include <algorithm>
+#include <memory>
+#include <span>
+
+#include "./Typedef.h"
+
+
+namespace goal {
+
+template<typename Id = int, typename Offset = long long>
+class CsrAdjacency {
+public:
+    using Row = std::span<Id>;
+    using ConstRow = std::span<const Id>;
+
+
+    CsrAdjacency() { clear(); }
+    CsrAdjacency(const Vec<Id>& capacities) { init(capacities); }
+    CsrAdjacency(const CsrAdjacency& other) : storage(other.storage) { bind(); }
+    CsrAdjacency(CsrAdjacency&& other) noexcept : storage(std::move(other.storage)) { bind(); other.clear(); }
+    CsrAdjacency& operator=(const CsrAdjacency& other) {
+        if (this != &other) { storage = other.storage; bind(); }
+        return *this;
+    }
+    CsrAdjacency& operator=(CsrAdjacency&& other) noexcept {
+        if (this != &other) { storage = std::move(other.storage); bind(); other.clear(); }
+        return *this;
+    }
+
+
+    // lay out empty rows, the i-th row can hold at most capacities[i] ids.
+    void init(const Vec<Id>& capacities) {
+        storage = std::make_shared<Storage>();
+        Id rowNum = sCast<Id>(capacities.size());
+        Vec<Offset>& offsets = storage->offsets;
+        offsets.resize(sCast<size_t>(rowNum) + 1);
+        offsets[0] = 0;
+        for (Id r = 0; r < rowNum; ++r) { offsets[r + 1] = offsets[r] + capacities[r]; }
+        storage->sizes.assign(sCast<size_t>(rowNum), 0);
+        storage->ids.resize(sCast<size_t>(offsets[rowNum]));
+        storage->capacities.clear();
+        bind();
+    }
+
+    // lay out rowNum rows with the given sizes and copy their ids (stored row after row) in.
+    void assign(const Id* rowSizes, Id rowNum, const Id* rowIds) {
+        storage = std::make_shared<Storage>();
+        Vec<Offset>& offsets = storage->offsets;
+        offsets.resize(sCast<size_t>(rowNum) + 1);
+        offsets[0] = 0;
+        for (Id r = 0; r < rowNum; ++r) { offsets[r + 1] = offsets[r] + rowSizes[r]; }
+        storage->sizes.assign(rowSizes, rowSizes + rowNum);
+        storage->ids.assign(rowIds, rowIds + offsets[rowNum]);
+        storage->capacities.clear();
+        bind();
+    }
+
+    void clear() {
+        storage = std::make_shared<Storage>();
+        storage->offsets.assign(1, 0);
+        bind();
+    }
+
+    // append id to the end of the row (no capacity check).
+    void pushBack(Id row, Id id) {
+        unshare();
+        idsPtr[offsetsPtr[row] + sizesPtr[row]++] = id;
+    }
+
+    // replace the ids of the row by rowIds[0, rowSize). the row is rewritten in place if they fit into
+    // its capacity, otherwise it moves to the end of the id array and its old space is reclaimed by keepRows().
+    void assignRow(Id row, const Id* rowIds, Id rowSize) {
+        unshare();
+        Vec<Id>& capacities = storage->capacities;
+        if (capacities.empty()) {
+            capacities.resize(sCast<size_t>(rowCount));
+            for (Id r = 0; r < rowCount; ++r) { capacities[r] = sCast<Id>(offsetsPtr[r + 1] - offsetsPtr[r]); }
+        }
+        if (rowSize > capacities[row]) {
+            Vec<Id>& ids = storage->ids;
+            storage->offsets[row] = sCast<Offset>(ids.size());
+            ids.resize(ids.size() + sCast<size_t>(rowSize));
+            storage->offsets[rowCount] = sCast<Offset>(ids.size());
+            capacities[row] = rowSize;
+            bind();
+        }
+        std::copy(rowIds, rowIds + rowSize, idsPtr + offsetsPtr[row]);
+        sizesPtr[row] = rowSize;
+    }
+
+    // shrink the row to its first newSize ids.
+    void resizeRow(Id row, Id newSize) {
+        unshare();
+        sizesPtr[row] = newSize;
+    }
+
+    // keep the rows listed in keptRows (in ascending order) as rows 0, 1, ...
+    // and rewrite each of their ids by mapId. the id array is compacted in place.
+    template<typename MapId>
+    void keepRows(const Vec<Id>& keptRows, MapId mapId) {
+        unshare();
+        Vec<Offset>& offsets = storage->offsets;
+        Vec<Id>& sizes = storage->sizes;
+        Vec<Id>& ids = storage->ids;
+        Id newRowNum = sCast<Id>(keptRows.size());
+        Offset cursor = 0;
+        if (!storage->capacities.empty()) {
+            // a moved row breaks the order of the rows in the id array, so they are copied out
+            Vec<Id> newIds;
+            for (Id r = 0; r < newRowNum; ++r) {
+                Id oldRow = keptRows[r];
+                Offset begin = offsets[oldRow];
+                Id size = sizes[oldRow];
+                for (Id i = 0; i < size; ++i) { newIds.push_back(mapId(ids[sCast<size_t>(begin + i)])); }
+                offsets[r] = cursor;
+                sizes[r] = size;
+                cursor += size;
+            }
+            ids.swap(newIds);
+            storage->capacities.clear();
+        } else {
+            for (Id r = 0; r < newRowNum; ++r) {
+                Id oldRow = keptRows[r];
+                Offset begin = offsets[oldRow];
+                Id size = sizes[oldRow];
+                for (Id i = 0; i < size; ++i) { ids[sCast<size_t>(cursor + i)] = mapId(ids[sCast<size_t>(begin + i)]); }
+                offsets[r] = cursor;
+                sizes[r] = size;
+                cursor += size;
+            }
+        }
+        offsets.resize(sCast<size_t>(newRowNum) + 1);
+        offsets[newRowNum] = cursor;
+        sizes.resize(sCast<size_t>(newRowNum));
+        ids.resize(sCast<size_t>(cursor));
+        bind();
+    }
+
+    // remove the unused capacity of all rows.
+    void compact() {
+        Vec<Id> allRows(sCast<size_t>(rowCount));
+        for (Id r = 0; r < rowCount; ++r) { allRows[r] = r; }
+        keepRows(allRows, [](Id id) { return id; });
+        storage->ids.shrink_to_fit();
+        bind();
+    }
+
+    // give this adjacency its own copy of the storage if it is shared.
+    void unshare() {
+        if (storage.use_count() > 1) {
+            storage = std::make_shared<Storage>(*storage);
+            bind();
+        }
+    }
+
+    Id rowNum() const { return rowCount; }
+    // number of rows.
+    size_t size() const { return sCast<size_t>(rowCount); }
+    bool empty() const { return rowCount == 0; }
+
+    Id degree(Id row) const { return sizesPtr[row]; }
+
+    Offset incidenceNum() const {
+        Offset n = 0;
+        for (Id r = 0; r < rowCount; ++r) { n += sizesPtr[r]; }
+        return n;
+    }
+
+    ConstRow operator[](Id row) const { return ConstRow(idsPtr + offsetsPtr[row], sCast<size_t>(sizesPtr[row])); }
+    Row mutableRow(Id row) {
+        unshare();
+        return Row(idsPtr + offsetsPtr[row], sCast<size_t>(sizesPtr[row]));
+    }
+
+protected:
+    struct Storage {
+        Vec<Offset> offsets; // offsets[i] is the start of the i-th row, offsets[rowNum()] is the capacity.
+        Vec<Id> sizes; // sizes[i] is the number of valid ids in the i-th row.
+        Vec<Id> ids;
+        Vec<Id> capacities; // capacities[i] is the room of the i-th row, only kept once a row has been reassigned.
+    };
+
+    // cache the raw pointers of the storage for the hot accessors.
+    void bind() {
+        offsetsPtr = storage->offsets.data();
+        sizesPtr = storage->sizes.data();
+        idsPtr = storage->ids.data();
+        rowCount = sCast<Id>(storage->sizes.size());
+    }
+
+
+    std::shared_ptr<Storage> storage;
+
+    Offset* offsetsPtr = nullptr;
+    Id* sizesPtr = nullptr;
+    Id* idsPtr = nullptr;
+    Id rowCount = 0;
+};
+
+}
+
+
+#endif // CN_HUST_GOAL_COMMON_CSR_ADJACENCY_H
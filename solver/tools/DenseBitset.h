@@ -0,0 +1,74 @@
+////////////////////////////////
+/// usage : 1.	set of the ids in [0, capacity) stored as one bit per id.
+///             `contains()` and `insert()` are a single load/store instead of a hash probe.
+///         2.	`size()` counts the members by popcount, `forEach()` visits them in ascending order.
+///
+/// note  : 1.	it will not consider index out of range error.
+///         2.	concurrent `contains()` is safe, concurrent `insert()` is not.
+////////////////////////////////
+
+#ifndef CN_HUST_GOAL_COMMON_DENSE_BITSET_H
+#define CN_HUST_GOAL_COMMON_DENSE_BITSET_H
+
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#include "./Typedef.h"
+
+
+namespace goal {
+
+class DenseBitset {
+public:
+    using Word = uint64_t;
+    static constexpr int WordBits = 64;
+
+
+    DenseBitset(ID capacity = 0) { reset(capacity); }
+
+
+    // remove all ids and make room for the ids in [0, capacity).
+    void reset(ID capacity) {
+        words.assign(sCast<size_t>(capacity + WordBits - 1) / WordBits, 0);
+        idNum = capacity;
+    }
+    void clear() { std::fill(words.begin(), words.end(), 0); }
+
+    bool contains(ID i) const { return (words[sCast<size_t>(i) / WordBits] >> (sCast<size_t>(i) % WordBits)) & 1; }
+
+    // return true if i was not in the set.
+    bool insert(ID i) {
+        Word& w = words[sCast<size_t>(i) / WordBits];
+        Word mask = Word(1) << (sCast<size_t>(i) % WordBits);
+        if (w & mask) { return false; }
+        w |= mask;
+        return true;
+    }
+    void erase(ID i) { words[sCast<size_t>(i) / WordBits] &= ~(Word(1) << (sCast<size_t>(i) % WordBits)); }
+
+    size_t size() const {
+        size_t n = 0;
+        for (Word w : words) { n += sCast<size_t>(std::popcount(w)); }
+        return n;
+    }
+    bool empty() const { return std::all_of(words.begin(), words.end(), [](Word w) { return w == 0; }); }
+    ID capacity() const { return idNum; }
+
+    template<typename Visit>
+    void forEach(Visit visit) const {
+        for (size_t k = 0; k < words.size(); ++k) {
+            for (Word w = words[k]; w; w &= w - 1) { visit(sCast<ID>(k * WordBits + sCast<size_t>(std::countr_zero(w)))); }
+        }
+    }
+
+protected:
+    Vec<Word> words;
+    ID idNum;
+};
+
+}
+
+
+#endif // CN_HUST_GOAL_COMMON_DENSE_BITSET_H
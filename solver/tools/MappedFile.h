@@ -0,0 +1,123 @@
+////////////////////////////////
+/// usage : 1.	read-only view of a whole input file or stream as one contiguous byte range.
+///             regular files are memory-mapped, other streams (pipes, terminals) are
+///             read in large blocks into an owned buffer.
+///
+/// note  : 1.	the view is not null-terminated, always use `data()` together with `size()`.
+///         2.	when opened from a FILE*, the view starts at the current offset of the stream
+///             and the stdio buffer of the stream must not have been filled before.
+////////////////////////////////
+
+#ifndef CN_HUST_GOAL_COMMON_MAPPED_FILE_H
+#define CN_HUST_GOAL_COMMON_MAPPED_FILE_H
+
+
+#include <cstdio>
+
+#include "./Typedef.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif // _WIN32
+
+
+namespace goal {
+
+class MappedFile {
+public:
+    static constexpr size_t ReadBlockSize = 64 * 1024 * 1024;
+
+
+    MappedFile() {}
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+
+    bool open(const Str& path) {
+        FILE* fp = fopen(path.c_str(), "rb");
+        if (!fp) { return false; }
+        bool ok = open(fp);
+        fclose(fp);
+        return ok;
+    }
+
+    bool open(FILE* fp) {
+        return map(fp) || readBlocks(fp);
+    }
+
+    // only succeed if the stream is a regular file which can be memory-mapped.
+    bool map(FILE* fp) {
+        close();
+        #ifndef _WIN32
+        return mapRegularFile(fileno(fp));
+        #else
+        return false;
+        #endif // _WIN32
+    }
+
+    void close() {
+        #ifndef _WIN32
+        if (mapAddr) { munmap(mapAddr, mapLen); }
+        #endif // _WIN32
+        mapAddr = nullptr; mapLen = 0;
+        Vec<char>().swap(buffer);
+        bytes = nullptr; byteNum = 0;
+    }
+
+    const char* data() const { return bytes; }
+    size_t size() const { return byteNum; }
+    bool isMapped() const { return mapAddr != nullptr; }
+
+protected:
+    #ifndef _WIN32
+    bool mapRegularFile(int fd) {
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) { return false; }
+        off_t offset = lseek(fd, 0, SEEK_CUR);
+        if (offset < 0 || offset > st.st_size) { return false; }
+        if (st.st_size == 0) { bytes = nullptr; byteNum = 0; return true; }
+
+        void* addr = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) { return false; }
+        madvise(addr, size_t(st.st_size), MADV_SEQUENTIAL);
+
+        mapAddr = addr; mapLen = size_t(st.st_size);
+        bytes = static_cast<const char*>(addr) + offset;
+        byteNum = mapLen - size_t(offset);
+        return true;
+    }
+    #endif // _WIN32
+
+    bool readBlocks(FILE* fp) {
+        size_t len = 0;
+        for (;;) {
+            if (buffer.size() < len + ReadBlockSize) { buffer.resize(len + ReadBlockSize); }
+            size_t n = fread(buffer.data() + len, 1, ReadBlockSize, fp);
+            len += n;
+            if (n < ReadBlockSize) { break; }
+        }
+        buffer.resize(len);
+        buffer.shrink_to_fit();
+        bytes = buffer.data(); byteNum = len;
+        return !ferror(fp);
+    }
+
+
+    const char* bytes = nullptr;
+    size_t byteNum = 0;
+
+    void* mapAddr = nullptr;
+    size_t mapLen = 0;
+    Vec<char> buffer;
+};
+
+}
+
+
+#endif // CN_HUST_GOAL_COMMON_MAPPED_FILE_H
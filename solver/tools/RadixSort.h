@@ -0,0 +1,56 @@
+////////////////////////////////
+/// usage : 1.	stable LSD radix sort of items by a 64-bit unsigned key.
+///             `radixSort(items, [](const Item& i) { return i.key; })`.
+///         2.	8 passes of 8 bits, a pass is skipped when all the keys share its digit,
+///             short arrays fall back to `std::stable_sort`.
+///
+/// note  : 1.	items of equal keys keep their relative order.
+////////////////////////////////
+
+#ifndef CN_HUST_GOAL_COMMON_RADIX_SORT_H
+#define CN_HUST_GOAL_COMMON_RADIX_SORT_H
+
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "./Typedef.h"
+
+
+namespace goal {
+
+template<typename Item, typename KeyOf>
+void radixSort(Vec<Item>& items, KeyOf keyOf) {
+    static constexpr size_t MinRadixSize = 256;
+    static constexpr int DigitBits = 8;
+    static constexpr int DigitNum = 64 / DigitBits;
+    static constexpr size_t Radix = size_t(1) << DigitBits;
+
+    if (items.size() < MinRadixSize) {
+        std::stable_sort(items.begin(), items.end(), [&](const Item& l, const Item& r) { return keyOf(l) < keyOf(r); });
+        return;
+    }
+
+    // count the digits of all passes at once.
+    std::array<std::array<size_t, Radix>, DigitNum> counts{};
+    for (const Item& item : items) {
+        uint64_t key = keyOf(item);
+        for (int d = 0; d < DigitNum; ++d) { ++counts[d][(key >> (d * DigitBits)) & (Radix - 1)]; }
+    }
+
+    Vec<Item> buffer(items.size());
+    for (int d = 0; d < DigitNum; ++d) {
+        std::array<size_t, Radix>& count = counts[d];
+        if (std::find(count.begin(), count.end(), items.size()) != count.end()) { continue; }
+        size_t offset = 0;
+        for (size_t& c : count) { size_t n = c; c = offset; offset += n; }
+        for (const Item& item : items) { buffer[count[(keyOf(item) >> (d * DigitBits)) & (Radix - 1)]++] = item; }
+        items.swap(buffer);
+    }
+}
+
+}
+
+
+#endif // CN_HUST_GOAL_COMMON_RADIX_SORT_H
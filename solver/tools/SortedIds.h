@@ -0,0 +1,144 @@
+////////////////////////////////
+/// usage : 1.	subset test of two strictly increasing int lists.
+///             `isSortedSubset(a, b)` tells whether every id of a is in b.
+///         2.	lists of similar lengths are compared block by block with SSE4.1/AVX2 when the cpu
+///             supports it (detected once at runtime), much longer second lists are galloped through.
+///
+/// note  : 1.	both lists must be sorted in increasing order without duplicates.
+///         2.	the SIMD paths are only compiled by gcc/clang for x86, other targets use the scalar code.
+////////////////////////////////
+
+#ifndef CN_HUST_GOAL_COMMON_SORTED_IDS_H
+#define CN_HUST_GOAL_COMMON_SORTED_IDS_H
+
+
+#include <algorithm>
+#include <span>
+
+#include "./Typedef.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GOAL_SORTED_IDS_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+
+namespace goal {
+
+namespace sorted_ids_impl {
+
+using Ids = std::span<const int>;
+
+// gallop when the second list is this many times longer than the first one.
+static constexpr size_t GallopRatio = 32;
+
+// first position in [pos, size) of b whose id is not less than v, by exponential then binary search.
+inline size_t gallop(const int* b, size_t pos, size_t size, int v) {
+    size_t step = 1, hi = pos;
+    while (hi < size && b[hi] < v) { pos = hi + 1; hi += step; step <<= 1; }
+    return sCast<size_t>(std::lower_bound(b + pos, b + std::min(hi, size), v) - b);
+}
+
+inline bool isSubsetGallop(Ids a, Ids b) {
+    size_t j = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        j = gallop(b.data(), j, b.size(), a[i]);
+        if (j == b.size() || b[j] != a[i]) { return false; }
+        ++j;
+    }
+    return true;
+}
+
+// binary search every id of a in the rest of b (faster than a branchy merge for short lists).
+inline bool isSubsetScalar(Ids a, Ids b) {
+    const int* pb = b.data();
+    const int* eb = pb + b.size();
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (sCast<size_t>(eb - pb) < a.size() - i) { return false; }
+        pb = std::lower_bound(pb, eb, a[i]);
+        if (pb == eb || *pb != a[i]) { return false; }
+        ++pb;
+    }
+    return true;
+}
+
+#ifdef GOAL_SORTED_IDS_X86_SIMD
+// skip the blocks of b whose last id is less than v, then look for v in the next block only,
+// since every id before the block is less than v and every id after it is greater.
+#define GOAL_SORTED_IDS_BLOCK_KERNELS(Suffix, Width, Target, LoadBlock, MatchMask)                     \
+__attribute__((target(Target))) inline bool isSubset##Suffix(Ids a, Ids b) {                           \
+    const int* pb = b.data(); size_t nb = b.size(), j = 0;                                             \
+    for (size_t i = 0; i < a.size(); ++i) {                                                            \
+        int v = a[i];                                                                                  \
+        while (j + Width <= nb && pb[j + Width - 1] < v) { j += Width; }                               \
+        if (nb - j < a.size() - i) { return false; }                                                   \
+        if (j + Width <= nb) {                                                                         \
+            unsigned mask = MatchMask(LoadBlock(pb + j), v);                                           \
+            if (!mask) { return false; }                                                               \
+            j += sCast<size_t>(__builtin_ctz(mask)) + 1;                                               \
+        } else {                                                                                       \
+            while (j < nb && pb[j] < v) { ++j; }                                                       \
+            if (j == nb || pb[j] != v) { return false; }                                               \
+            ++j;                                                                                       \
+        }                                                                                              \
+    }                                                                                                  \
+    return true;                                                                                       \
+}
+
+__attribute__((target("sse4.1"))) inline __m128i loadBlock128(const int* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+__attribute__((target("sse4.1"))) inline unsigned matchMask128(__m128i block, int v) {
+    return sCast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, _mm_set1_epi32(v)))));
+}
+__attribute__((target("avx2"))) inline __m256i loadBlock256(const int* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+__attribute__((target("avx2"))) inline unsigned matchMask256(__m256i block, int v) {
+    return sCast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, _mm256_set1_epi32(v)))));
+}
+
+GOAL_SORTED_IDS_BLOCK_KERNELS(Sse4, 4, "sse4.1", loadBlock128, matchMask128)
+GOAL_SORTED_IDS_BLOCK_KERNELS(Avx2, 8, "avx2", loadBlock256, matchMask256)
+
+#undef GOAL_SORTED_IDS_BLOCK_KERNELS
+#endif // GOAL_SORTED_IDS_X86_SIMD
+
+enum class KernelKind { Scalar, Sse4, Avx2 };
+
+inline KernelKind detectKernel() {
+    #ifdef GOAL_SORTED_IDS_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) { return KernelKind::Avx2; }
+    if (__builtin_cpu_supports("sse4.1")) { return KernelKind::Sse4; }
+    #endif // GOAL_SORTED_IDS_X86_SIMD
+    return KernelKind::Scalar;
+}
+
+inline KernelKind kernel() {
+    static const KernelKind kind = detectKernel();
+    return kind;
+}
+
+}
+
+
+inline bool isSortedSubset(std::span<const int> a, std::span<const int> b) {
+    using namespace sorted_ids_impl;
+    if (a.size() > b.size()) { return false; }
+    if (a.empty()) { return true; }
+    if (a.front() < b.front() || a.back() > b.back()) { return false; }
+    if (b.size() >= a.size() * GallopRatio) { return isSubsetGallop(a, b); }
+    switch (kernel()) {
+    #ifdef GOAL_SORTED_IDS_X86_SIMD
+    case KernelKind::Avx2: return isSubsetAvx2(a, b);
+    case KernelKind::Sse4: return isSubsetSse4(a, b);
+    #endif // GOAL_SORTED_IDS_X86_SIMD
+    default: return isSubsetScalar(a, b);
+    }
+}
+
+}
+
+
+#endif // CN_HUST_GOAL_COMMON_SORTED_IDS_H